@@ -0,0 +1,138 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+#include "app/StateStore.h"
+
+namespace {
+    using BenchClock = std::chrono::steady_clock;
+
+    constexpr std::size_t kIterations = 2'000'000;
+    constexpr std::uint32_t kSeed = 0xC0FFEE;
+
+    constexpr ChangeMask kBgColorChanged = 1u << 0;
+    constexpr ChangeMask kClientSizeChanged = 1u << 1;
+    constexpr ChangeMask kChildHwndChanged = 1u << 2;
+    constexpr ChangeMask kChildOpenChanged = 1u << 3;
+
+    struct Size {
+        int width = 0;
+        int height = 0;
+
+        bool operator==(const Size &) const = default;
+    };
+
+    // Stand-in for AppState, same kinds of fields and keys
+    struct BenchState {
+        explicit BenchState(ChangeBus &bus)
+            : bgColor(bus, kBgColorChanged),
+              clientSize(bus, kClientSizeChanged),
+              childHandle(bus, kChildHwndChanged),
+              childOpen(bus, kChildOpenChanged) {}
+
+        Observable<std::uint32_t> bgColor;
+        Observable<Size> clientSize;
+        Observable<std::uintptr_t> childHandle;
+        Observable<bool> childOpen;
+    };
+
+    struct Result {
+        double nsPerIteration = 0.0;
+        std::size_t writes = 0;
+        std::size_t delivered = 0;
+        std::size_t immediate = 0;
+    };
+
+    /**
+     * Each iteration plays one message loop turn: a handler makes several writes, then the loop flushes.
+     * 'immediate' counts the subscriber calls an unbatched design would have made, one per write
+     */
+    Result RunLoop(std::size_t writesPerHandler, std::size_t extraSubscribers) {
+        ChangeBus bus;
+        BenchState state(bus);
+
+        std::size_t layouts = 0, paints = 0, children = 0, others = 0;
+        bus.Subscribe(kClientSizeChanged, [&layouts](ChangeMask) { ++layouts; });
+        bus.Subscribe(kBgColorChanged | kClientSizeChanged, [&paints](ChangeMask) { ++paints; });
+        bus.Subscribe(kChildHwndChanged | kChildOpenChanged, [&children](ChangeMask) { ++children; });
+        for (std::size_t i = 0; i < extraSubscribers; ++i) {
+            bus.Subscribe(ChangeMask{1} << (4 + i % 60), [&others](ChangeMask) { ++others; });
+        }
+
+        std::mt19937 gen{kSeed};
+        std::uniform_int_distribution<int> field(0, 3);
+        std::uniform_int_distribution<int> dimension(100, 4000);
+
+        Result result;
+        const auto start = BenchClock::now();
+        for (std::size_t i = 0; i < kIterations; ++i) {
+            for (std::size_t w = 0; w < writesPerHandler; ++w) {
+                switch (field(gen)) {
+                    case 0:
+                        state.bgColor.Set(static_cast<std::uint32_t>(gen()));
+                        result.immediate += 1;
+                        break;
+                    case 1:
+                        state.clientSize.Set({dimension(gen), dimension(gen)});
+                        result.immediate += 2;
+                        break;
+                    case 2:
+                        state.childHandle.Set(state.childHandle.Get() + 1);
+                        result.immediate += 1;
+                        break;
+                    default:
+                        state.childOpen.Set(!state.childOpen.Get());
+                        result.immediate += 1;
+                        break;
+                }
+                ++result.writes;
+            }
+            result.delivered += bus.Flush();
+        }
+        const auto elapsed = std::chrono::duration<double, std::nano>(BenchClock::now() - start);
+
+        result.nsPerIteration = elapsed.count() / kIterations;
+        return result;
+    }
+
+    // Raw throughput of writes that coalesce into a single pending batch
+    double RunCoalescedWrites() {
+        ChangeBus bus;
+        BenchState state(bus);
+        bus.Subscribe(kBgColorChanged, [](ChangeMask) {});
+
+        constexpr std::size_t kWrites = 20'000'000;
+        const auto start = BenchClock::now();
+        for (std::size_t i = 0; i < kWrites; ++i) {
+            state.bgColor.Set(static_cast<std::uint32_t>(i));
+        }
+        bus.Flush();
+        const auto elapsed = std::chrono::duration<double, std::nano>(BenchClock::now() - start);
+
+        return elapsed.count() / kWrites;
+    }
+}
+
+/**
+ * Notification throughput of the batched state store, writes per handler and subscriber count vary
+ */
+int main() {
+    std::printf("coalesced write: %.2f ns/op\n\n", RunCoalescedWrites());
+    std::printf("%-8s %-12s %14s %16s %16s %14s\n",
+                "writes", "subscribers", "ns/iteration", "Mwrites/s", "callbacks/iter", "unbatched/iter");
+
+    for (const std::size_t writes : {std::size_t{1}, std::size_t{4}, std::size_t{16}}) {
+        for (const std::size_t extra : {std::size_t{0}, std::size_t{61}}) {
+            const Result r = RunLoop(writes, extra);
+            const double seconds = r.nsPerIteration * kIterations / 1e9;
+
+            std::printf("%-8zu %-12zu %14.1f %16.1f %16.2f %14.2f\n",
+                        writes, extra + 3, r.nsPerIteration, static_cast<double>(r.writes) / seconds / 1e6,
+                        static_cast<double>(r.delivered) / kIterations,
+                        static_cast<double>(r.immediate) / kIterations);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include "app/Theme.h"
+#include "app/ThemeEngine.h"
+
+namespace {
+    using BenchClock = std::chrono::steady_clock;
+
+    constexpr int kApplies = 200;
+
+    constexpr StyleBinding kWindowBinding{ThemeRole::WindowBg, ThemeRole::WindowBg, ThemeRole::WindowBg};
+    constexpr StyleBinding kButtonBinding{ThemeRole::ButtonBg, ThemeRole::ButtonText, ThemeRole::ButtonBorder};
+    constexpr StyleBinding kLabelBinding{ThemeRole::ChildBg, ThemeRole::LabelText, ThemeRole::ChildBg};
+    constexpr StyleBinding kListBinding{ThemeRole::ListBg, ThemeRole::ListText, ThemeRole::ListGrid};
+
+    // Alternates between two tables and reports the average cost and restyle count of one Apply
+    void RunApplies(const char *name, ThemeEngine &engine, const ThemeTable &a, const ThemeTable &b,
+                    std::size_t &invalidations) {
+        engine.Apply(a);
+        invalidations = 0;
+
+        std::size_t restyled = 0;
+        const auto start = BenchClock::now();
+        for (int i = 0; i < kApplies; ++i) {
+            restyled += engine.Apply(i % 2 ? a : b);
+        }
+        const auto elapsed = std::chrono::duration<double, std::micro>(BenchClock::now() - start);
+
+        std::printf("  %-34s %10.2f us/apply %10zu restyled/apply %10zu callbacks\n",
+                    name, elapsed.count() / kApplies, restyled / kApplies, invalidations / kApplies);
+    }
+}
+
+/**
+ * Screens with thousands of controls where a theme switch touches few, some or all of them,
+ * apply cost should follow the number of restyled controls and not the registered total
+ */
+int main() {
+    for (const std::size_t controlCount : {std::size_t{1'000}, std::size_t{10'000}, std::size_t{100'000}}) {
+        ThemeEngine engine(kDarkTheme);
+        std::size_t invalidations = 0;
+
+        // Mostly buttons and labels, one window and a handful of lists
+        engine.Register(kWindowBinding, [&invalidations](const Style &) { ++invalidations; });
+        for (std::size_t i = 1; i < controlCount; ++i) {
+            const StyleBinding binding = i % 500 == 0 ? kListBinding : (i % 2 ? kButtonBinding : kLabelBinding);
+            engine.Register(binding, [&invalidations](const Style &) { ++invalidations; });
+        }
+
+        ThemeTable gridTweak = kDarkTheme;
+        gridTweak[ThemeRole::ListGrid] = MakeColour(90, 90, 90);
+
+        ThemeTable windowTweak = kDarkTheme;
+        windowTweak[ThemeRole::WindowBg] = MakeColour(10, 10, 40);
+
+        std::printf("%zu controls\n", engine.ControlCount());
+        RunApplies("same table (empty diff)", engine, kDarkTheme, kDarkTheme, invalidations);
+        RunApplies("window.bg only", engine, kDarkTheme, windowTweak, invalidations);
+        RunApplies("list.grid only", engine, kDarkTheme, gridTweak, invalidations);
+        RunApplies("dark <-> light (every role)", engine, kDarkTheme, kLightTheme, invalidations);
+    }
+
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "app/TimerWheel.h"
+
+namespace {
+    using BenchClock = std::chrono::steady_clock;
+
+    constexpr std::size_t kPendingTimers = 100'000;
+    constexpr std::uint64_t kMaxDelayMs = 60'000;
+    constexpr std::uint32_t kSeed = 0xC0FFEE;
+
+    double NanosPer(BenchClock::time_point start, std::size_t ops) {
+        const auto elapsed = std::chrono::duration<double, std::nano>(BenchClock::now() - start);
+        return ops ? elapsed.count() / static_cast<double>(ops) : 0.0;
+    }
+
+    void Report(const char *name, double nsPerOp, std::size_t ops) {
+        std::printf("%-40s %10.1f ns/op  (%zu ops)\n", name, nsPerOp, ops);
+    }
+}
+
+/**
+ * Measures the costs the message loop pays with 100k pending UI timers: arming, cancelling,
+ * querying the next wake-up and draining expirations, plus a debounce-style re-arm churn
+ */
+int main() {
+    std::mt19937 gen{kSeed};
+    std::uniform_int_distribution<std::uint64_t> delays(1, kMaxDelayMs);
+
+    std::size_t firedTotal = 0;
+    TimerWheel wheel(0);
+    std::vector<TimerWheel::TimerId> ids;
+    ids.reserve(kPendingTimers);
+
+    // 1) Arming 100k timers spread over a minute
+    auto start = BenchClock::now();
+    for (std::size_t i = 0; i < kPendingTimers; ++i) {
+        ids.push_back(wheel.Schedule(delays(gen), [&firedTotal] { ++firedTotal; }));
+    }
+    Report("schedule (100k pending)", NanosPer(start, kPendingTimers), kPendingTimers);
+
+    // 2) Next wake-up query, done once per message loop iteration
+    constexpr std::size_t kQueries = 1'000'000;
+    std::uint64_t sink = 0;
+    start = BenchClock::now();
+    for (std::size_t i = 0; i < kQueries; ++i) {
+        sink += wheel.NextDeadline().value_or(0);
+    }
+    Report("next deadline query", NanosPer(start, kQueries), kQueries);
+
+    // 3) Debounce churn, cancel a live timer and re-arm it with a fresh delay
+    constexpr std::size_t kChurn = 1'000'000;
+    std::uniform_int_distribution<std::size_t> pick(0, kPendingTimers - 1);
+    start = BenchClock::now();
+    for (std::size_t i = 0; i < kChurn; ++i) {
+        const std::size_t victim = pick(gen);
+        wheel.Cancel(ids[victim]);
+        ids[victim] = wheel.Schedule(delays(gen), [&firedTotal] { ++firedTotal; });
+    }
+    Report("cancel + re-arm churn", NanosPer(start, kChurn), kChurn);
+
+    // 4) Cancelling half of the pending timers
+    start = BenchClock::now();
+    for (std::size_t i = 0; i < kPendingTimers; i += 2) {
+        wheel.Cancel(ids[i]);
+    }
+    Report("cancel (half of pending)", NanosPer(start, kPendingTimers / 2), kPendingTimers / 2);
+
+    // 5) Draining in 16ms frames, roughly one message loop wake-up per frame
+    const std::size_t pendingBeforeDrain = wheel.Size();
+    std::size_t wakeUps = 0;
+    start = BenchClock::now();
+    for (std::uint64_t now = 0; wheel.Size() > 0; now += 16) {
+        wheel.Advance(now);
+        ++wakeUps;
+    }
+    Report("advance, per fired timer", NanosPer(start, pendingBeforeDrain), pendingBeforeDrain);
+
+    // 6) Sparse wake-ups, jumping straight to each reported deadline
+    for (std::size_t i = 0; i < kPendingTimers; ++i) {
+        wheel.Schedule(delays(gen), [&firedTotal] { ++firedTotal; });
+    }
+    std::size_t jumps = 0;
+    start = BenchClock::now();
+    while (const auto next = wheel.NextDeadline()) {
+        wheel.Advance(*next);
+        ++jumps;
+    }
+    Report("advance to next deadline, per wake-up", NanosPer(start, jumps), jumps);
+
+    std::printf("fired %zu timers over %zu frame wake-ups (checksum %llu)\n",
+                firedTotal, wakeUps, static_cast<unsigned long long>(sink));
+    return 0;
+}
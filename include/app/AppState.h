@@ -1,23 +1,72 @@
 #pragma once
 #include <Windows.h>
 
+#include "app/StateStore.h"
+#include "app/ThemeEngine.h"
+
 class ButtonManager;
+class TimerWheel;
+class VirtualListView;
+
+struct ClientSize {
+    int width = 0;
+    int height = 0;
+
+    bool operator==(const ClientSize &) const = default;
+};
 
 /**
  * AppState is owned by the parent window, passed through
  * lpCreateParams (heap-allocated) and destroyed in
- * the parents' WM_NCDESTROY function
+ * the parents' WM_NCDESTROY function. Observable fields
+ * queue their change key on the bus owned by main,
+ * subscribers react once per message loop iteration
  */
 struct AppState {
+    static constexpr ChangeMask kBgColorChanged = 1u << 0;
+    static constexpr ChangeMask kClientSizeChanged = 1u << 1;
+    static constexpr ChangeMask kChildHwndChanged = 1u << 2;
+
+    explicit AppState(ChangeBus &changes)
+        : changes(changes),
+          bgColor(changes, kBgColorChanged, kDefaultTheme[ThemeRole::WindowBg]),
+          clientSize(changes, kClientSizeChanged),
+          childHwnd(changes, kChildHwndChanged, nullptr) {}
+
+    ChangeBus &changes;
+
     // UI utilities
-    COLORREF bgColor = RGB(20, 20, 20);
+    Observable<COLORREF> bgColor;
+    Observable<ClientSize> clientSize;
     HFONT childLabelFont = nullptr;
 
     // Tracking the child window lifecycle
-    HWND childHwnd = nullptr;
+    Observable<HWND> childHwnd;
     bool childOpen = false;
 
+    // Theme registrations of the child window and its OK button, 'childThemeHwnd' is the child they capture
+    ThemeEngine::ControlId childThemeId = ThemeEngine::kNoControl;
+    ThemeEngine::ControlId childOkThemeId = ThemeEngine::kNoControl;
+    HWND childThemeHwnd = nullptr;
+
+    // Subscriptions made by the parent window, dropped in its WM_NCDESTROY
+    ChangeBus::SubscriptionId layoutSubscription = ChangeBus::kNoSubscription;
+    ChangeBus::SubscriptionId paintSubscription = ChangeBus::kNoSubscription;
+    ChangeBus::SubscriptionId childSubscription = ChangeBus::kNoSubscription;
+
+    // Set between WM_ENTERSIZEMOVE and WM_EXITSIZEMOVE, the modal sizing loop bypasses main's loop
+    bool inSizeMove = false;
+
     // Non-owning pointers to ButtonManager instances created in main
     ButtonManager *btn1 = nullptr;
     ButtonManager *btn2 = nullptr;
+
+    // Non-owning pointer to the colour list, laid out below the buttons
+    VirtualListView *list = nullptr;
+
+    // Non-owning pointer to the timer wheel driven by the message loop in main
+    TimerWheel *timers = nullptr;
+
+    // Non-owning pointer to the theme engine created in main
+    ThemeEngine *theme = nullptr;
 };
@@ -26,6 +26,7 @@ public:
     void SetSizeAndPosition(int x, int y, int width, int height);
     void ComputeResize(int updWinWidth, int updWinHeight);
     void DestroyButton();
+    void SetColors(COLORREF newBgColor, COLORREF newTextColor, COLORREF newBorderColor);
 
     [[nodiscard]] COLORREF GetBgColor() const;
     [[nodiscard]] COLORREF GetTextColor() const;
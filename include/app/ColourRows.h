@@ -0,0 +1,21 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "app/VirtualList.h"
+
+/**
+ * ColourRows is the demo data source of the main window's list, one row per 24-bit RGB colour
+ * (hex code and its three channels) generated on demand, so the list shows 16.7 million rows
+ * without storing any of them
+ */
+class ColourRows final : public RowProvider {
+public:
+    static constexpr std::size_t kColumns = 4;
+
+    [[nodiscard]] std::size_t RowCount() const override;
+    [[nodiscard]] std::size_t ColumnCount() const override;
+
+    void FetchRow(std::size_t row, std::vector<std::wstring> &cells) override;
+};
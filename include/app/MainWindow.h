@@ -0,0 +1,49 @@
+#pragma once
+#include <Windows.h>
+#include <memory>
+
+#include "app/ColourRows.h"
+#include "app/ThemeEngine.h"
+
+class ButtonManager;
+class ChangeBus;
+class TimerWheel;
+class VirtualListView;
+
+/**
+ * MainWindow builds everything WinMain shows: the parent window with its AppState, the buttons,
+ * the colour list and their theme registrations. The message loop and the theme file watcher stay with the caller,
+ * which also owns the timer wheel, theme engine and change bus so they outlive this object
+ */
+class MainWindow {
+public:
+    MainWindow(HINSTANCE hInstance, TimerWheel &timers, ThemeEngine &theme, ChangeBus &changes);
+
+    ~MainWindow();
+
+    MainWindow(const MainWindow&) = delete;
+    MainWindow& operator=(const MainWindow&) = delete;
+    MainWindow(MainWindow&&) = delete;
+    MainWindow& operator=(MainWindow&&) = delete;
+
+    static bool RegisterWindowClass(HINSTANCE hInstance);
+    static void UnregisterWindowClass(HINSTANCE hInstance);
+
+    [[nodiscard]] HWND GetHwnd() const;
+
+private:
+    HWND hwnd = nullptr;
+    ThemeEngine &theme;
+
+    std::unique_ptr<ButtonManager> button1;
+    std::unique_ptr<ButtonManager> button2;
+
+    // Declared before the list so it outlives the view pulling rows from it
+    ColourRows colourRows;
+    std::unique_ptr<VirtualListView> colourList;
+
+    ThemeEngine::ControlId windowThemeId = ThemeEngine::kNoControl;
+    ThemeEngine::ControlId button1ThemeId = ThemeEngine::kNoControl;
+    ThemeEngine::ControlId button2ThemeId = ThemeEngine::kNoControl;
+    ThemeEngine::ControlId listThemeId = ThemeEngine::kNoControl;
+};
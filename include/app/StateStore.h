@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// One bit per observable field, a batch is the union of every key written since the last flush
+using ChangeMask = std::uint64_t;
+
+/**
+ * ChangeBus collects change notifications from Observable writes and delivers them as one
+ * coalesced batch per Flush, the message loop flushes once per iteration so several writes in
+ * a handler cause a single layout or repaint. Writes made by subscribers land in the next batch
+ */
+class ChangeBus {
+public:
+    using Subscriber = std::function<void(ChangeMask)>;
+    using SubscriptionId = std::uint32_t;
+
+    static constexpr SubscriptionId kNoSubscription = 0xFFFFFFFFu;
+
+    SubscriptionId Subscribe(ChangeMask interest, Subscriber subscriber);
+    void Unsubscribe(SubscriptionId id);
+    std::size_t Flush();
+
+    void Notify(ChangeMask changed) { pending |= changed; }
+
+    [[nodiscard]] bool HasPending() const { return pending != 0; }
+    [[nodiscard]] ChangeMask Pending() const { return pending; }
+
+private:
+    struct Entry {
+        ChangeMask interest = 0;
+        Subscriber subscriber;
+    };
+
+    std::vector<Entry> entries;
+    std::vector<SubscriptionId> freeIds;
+
+    // Subscriptions made while flushing are parked here so 'entries' never reallocates mid-call
+    std::vector<std::pair<SubscriptionId, Entry>> added;
+
+    ChangeMask pending = 0;
+    bool flushing = false;
+};
+
+/**
+ * Observable wraps one state field, writing a different value stores it and queues the field's
+ * key on the bus, writing the same value is free and notifies nobody
+ */
+template <typename T>
+class Observable {
+public:
+    Observable(ChangeBus &bus, ChangeMask key, T initial = T{})
+        : bus(&bus), key(key), value(std::move(initial)) {}
+
+    Observable(const Observable&) = delete;
+    Observable& operator=(const Observable&) = delete;
+
+    [[nodiscard]] const T &Get() const { return value; }
+
+    void Set(T newValue) {
+        if (newValue == value) return;
+        value = std::move(newValue);
+        bus->Notify(key);
+    }
+
+private:
+    ChangeBus *bus;
+    ChangeMask key;
+    T value;
+};
@@ -0,0 +1,134 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+// Same 0x00BBGGRR layout as COLORREF, so values pass straight into GDI calls
+using Colour = std::uint32_t;
+
+constexpr Colour MakeColour(std::uint8_t r, std::uint8_t g, std::uint8_t b) {
+    return static_cast<Colour>(r) | (static_cast<Colour>(g) << 8) | (static_cast<Colour>(b) << 16);
+}
+
+// Rec. 709 luma below mid grey, decides between a dark and a light title bar for a background colour
+constexpr bool IsDarkColour(Colour colour) {
+    const Colour r = colour & 0xFF;
+    const Colour g = (colour >> 8) & 0xFF;
+    const Colour b = (colour >> 16) & 0xFF;
+    return r * 2126 + g * 7152 + b * 722 < 128 * 10000;
+}
+
+// Every colour slot a theme defines, controls bind their style fields to these roles
+enum class ThemeRole : std::uint8_t {
+    WindowBg,
+    ButtonBg,
+    ButtonText,
+    ButtonBorder,
+    ChildBg,
+    LabelText,
+    ListBg,
+    ListText,
+    ListGrid,
+    Count
+};
+
+constexpr std::size_t kThemeRoleCount = static_cast<std::size_t>(ThemeRole::Count);
+
+struct ThemeTable {
+    std::array<Colour, kThemeRoleCount> colours{};
+
+    [[nodiscard]] constexpr Colour operator[](ThemeRole role) const {
+        return colours[static_cast<std::size_t>(role)];
+    }
+
+    constexpr Colour &operator[](ThemeRole role) {
+        return colours[static_cast<std::size_t>(role)];
+    }
+
+    constexpr bool operator==(const ThemeTable &) const = default;
+};
+
+struct BuiltInTheme {
+    std::string_view name;
+    ThemeTable table;
+};
+
+// Names used for roles in theme files, in ThemeRole order
+inline constexpr std::array<std::string_view, kThemeRoleCount> kThemeRoleNames{
+    "window.bg",
+    "button.bg",
+    "button.text",
+    "button.border",
+    "child.bg",
+    "label.text",
+    "list.bg",
+    "list.text",
+    "list.grid",
+};
+
+inline constexpr ThemeTable kDarkTheme{{
+    MakeColour(20, 20, 20),
+    MakeColour(35, 35, 35),
+    MakeColour(255, 255, 255),
+    MakeColour(255, 255, 255),
+    MakeColour(30, 30, 30),
+    MakeColour(255, 255, 255),
+    MakeColour(25, 25, 25),
+    MakeColour(230, 230, 230),
+    MakeColour(55, 55, 55),
+}};
+
+inline constexpr ThemeTable kLightTheme{{
+    MakeColour(243, 243, 243),
+    MakeColour(225, 225, 225),
+    MakeColour(20, 20, 20),
+    MakeColour(120, 120, 120),
+    MakeColour(250, 250, 250),
+    MakeColour(20, 20, 20),
+    MakeColour(255, 255, 255),
+    MakeColour(30, 30, 30),
+    MakeColour(215, 215, 215),
+}};
+
+inline constexpr ThemeTable kHighContrastTheme{{
+    MakeColour(0, 0, 0),
+    MakeColour(0, 0, 0),
+    MakeColour(255, 255, 0),
+    MakeColour(255, 255, 255),
+    MakeColour(0, 0, 0),
+    MakeColour(255, 255, 255),
+    MakeColour(0, 0, 0),
+    MakeColour(255, 255, 255),
+    MakeColour(0, 255, 255),
+}};
+
+inline constexpr std::array<BuiltInTheme, 3> kBuiltInThemes{{
+    {"dark", kDarkTheme},
+    {"light", kLightTheme},
+    {"high-contrast", kHighContrastTheme},
+}};
+
+// Dark matches the colours the program always shipped with
+inline constexpr ThemeTable kDefaultTheme = kDarkTheme;
+
+[[nodiscard]] std::optional<ThemeTable> FindBuiltInTheme(std::string_view name);
+[[nodiscard]] std::optional<ThemeTable> ParseTheme(std::string_view text, std::string *error = nullptr);
+
+/**
+ * ThemeFileWatcher polls a user theme file's write time, the owner drives Poll from a timer
+ * so a saved edit is picked up without restarting the program
+ */
+class ThemeFileWatcher {
+public:
+    explicit ThemeFileWatcher(std::filesystem::path path);
+
+    [[nodiscard]] std::optional<ThemeTable> Poll(std::string *error = nullptr);
+
+private:
+    std::filesystem::path path;
+    std::optional<std::filesystem::file_time_type> lastWrite;
+};
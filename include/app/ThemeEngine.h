@@ -0,0 +1,86 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "app/Theme.h"
+
+// Resolved colours a control paints with
+struct Style {
+    Colour bg = 0;
+    Colour text = 0;
+    Colour border = 0;
+
+    bool operator==(const Style &) const = default;
+};
+
+// Which theme role feeds each style field of a control
+struct StyleBinding {
+    ThemeRole bg = ThemeRole::WindowBg;
+    ThemeRole text = ThemeRole::WindowBg;
+    ThemeRole border = ThemeRole::WindowBg;
+};
+
+/**
+ * ThemeEngine keeps the active theme table and the controls styled by it, indexed by theme role.
+ * Applying a theme diffs the two tables and only revisits controls bound to a changed role,
+ * so switching costs time proportional to the change rather than to the number of controls.
+ * Restyle callbacks may register or unregister controls, but an Apply made from one is ignored
+ */
+class ThemeEngine {
+public:
+    using ControlId = std::uint32_t;
+    using RestyleCallback = std::function<void(const Style &)>;
+
+    static constexpr ControlId kNoControl = 0xFFFFFFFFu;
+
+    explicit ThemeEngine(const ThemeTable &initial = kDefaultTheme);
+
+    ControlId Register(StyleBinding binding, RestyleCallback onRestyle);
+    void Unregister(ControlId id);
+    std::size_t Apply(const ThemeTable &next);
+
+    [[nodiscard]] Colour RoleColour(ThemeRole role) const;
+    [[nodiscard]] const Style &StyleOf(ControlId id) const;
+    [[nodiscard]] const ThemeTable &Current() const;
+    [[nodiscard]] std::size_t ControlCount() const;
+
+private:
+    static constexpr std::uint32_t kNotListed = 0xFFFFFFFFu;
+
+    struct Control {
+        StyleBinding binding;
+        Style style;
+        RestyleCallback onRestyle;
+
+        // Position inside roleControls for each distinct role bound, kNotListed for duplicates
+        std::array<std::uint32_t, 3> rolePos{kNotListed, kNotListed, kNotListed};
+        std::uint64_t visitedApply = 0;
+
+        // Bumped by Unregister, tells a reused id apart from the control it replaced
+        std::uint32_t generation = 0;
+        bool live = false;
+    };
+
+    struct Restyled {
+        ControlId id = 0;
+        std::uint32_t generation = 0;
+    };
+
+    [[nodiscard]] Style Resolve(const StyleBinding &binding) const;
+    [[nodiscard]] static std::array<ThemeRole, 3> Roles(const StyleBinding &binding);
+
+    ThemeTable table;
+    std::vector<Control> controls;
+    std::vector<ControlId> freeIds;
+    std::array<std::vector<ControlId>, kThemeRoleCount> roleControls;
+
+    std::uint64_t applyCount = 0;
+    std::size_t liveCount = 0;
+    bool applying = false;
+
+    // Reused between Apply calls so restyling does not allocate
+    std::vector<Restyled> restyled;
+};
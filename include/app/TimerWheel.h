@@ -0,0 +1,78 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+/**
+ * TimerWheel is a hierarchical timing wheel owned by the message loop in WinMain,
+ * times are plain millisecond ticks (GetTickCount64 on Windows) so the wheel itself stays portable.
+ * Six levels of 64 slots cover delays of roughly two years, insert and cancel are O(1),
+ * expired callbacks are collected and fired as a single batch per Advance call.
+ * Modal loops (sizing, menus, the close dialog) bypass WinMain's loop, meanwhile the window procs
+ * drive Advance from a single WM_TIMER armed for the nearest deadline
+ */
+class TimerWheel {
+public:
+    using Callback = std::function<void()>;
+
+    // Generation-checked handle, a stale id (fired or cancelled timer) is safely ignored by Cancel
+    struct TimerId {
+        std::uint32_t index = 0;
+        std::uint32_t generation = 0;
+    };
+
+    static constexpr int kLevels = 6;
+    static constexpr int kSlotBits = 6;
+    static constexpr int kSlots = 1 << kSlotBits;
+    static constexpr std::uint64_t kMaxDelay =
+        (std::uint64_t{1} << (kLevels * kSlotBits)) - (std::uint64_t{1} << ((kLevels - 1) * kSlotBits));
+
+    explicit TimerWheel(std::uint64_t nowMs = 0);
+
+    TimerId Schedule(std::uint64_t delayMs, Callback callback);
+    bool Cancel(TimerId id);
+    std::size_t Advance(std::uint64_t nowMs);
+
+    [[nodiscard]] std::optional<std::uint64_t> NextDeadline() const;
+    [[nodiscard]] std::uint64_t Now() const;
+    [[nodiscard]] std::size_t Size() const;
+
+private:
+    static constexpr std::uint32_t kNil = 0xFFFFFFFFu;
+
+    struct Node {
+        std::uint64_t deadline = 0;
+        std::uint32_t prev = kNil, next = kNil;
+        std::uint32_t generation = 0;
+        std::uint16_t bucket = 0;
+        bool armed = false;
+        Callback callback;
+    };
+
+    struct Expiration {
+        int level = 0;
+        int slot = 0;
+        std::uint64_t deadline = 0;
+    };
+
+    [[nodiscard]] std::optional<Expiration> NextExpiration() const;
+    void Insert(std::uint32_t index);
+    void Unlink(std::uint32_t index);
+    std::uint32_t AllocateNode();
+    void ReleaseNode(std::uint32_t index);
+
+    std::uint64_t elapsed = 0;
+    std::size_t armedCount = 0;
+
+    std::vector<Node> nodes;
+    std::uint32_t freeHead = kNil;
+
+    std::array<std::uint32_t, kLevels * kSlots> slotHeads{};
+    std::array<std::uint64_t, kLevels> occupied{};
+
+    // Reused between Advance calls so firing a batch does not allocate
+    std::vector<Callback> firing;
+};
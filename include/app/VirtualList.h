@@ -0,0 +1,98 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * RowProvider is the pull-based data source of a virtualized list, rows are only requested
+ * while they are visible so the dataset can be arbitrarily large or generated on the fly
+ */
+class RowProvider {
+public:
+    virtual ~RowProvider() = default;
+
+    [[nodiscard]] virtual std::size_t RowCount() const = 0;
+    [[nodiscard]] virtual std::size_t ColumnCount() const = 0;
+
+    // Fills one row, 'cells' is recycled storage already sized to ColumnCount()
+    virtual void FetchRow(std::size_t row, std::vector<std::wstring> &cells) = 0;
+};
+
+struct RowRange {
+    std::size_t first = 0;
+    std::size_t last = 0;  // exclusive
+
+    [[nodiscard]] bool Empty() const { return first >= last; }
+};
+
+// Outcome of a scroll, either blit the old content by 'pixels' and paint 'exposed', or repaint everything
+struct ScrollResult {
+    std::int64_t pixels = 0;
+    bool repaintAll = false;
+    RowRange exposed;
+};
+
+struct CellHit {
+    std::size_t row = 0;
+    std::size_t column = 0;
+    bool valid = false;
+};
+
+/**
+ * VirtualList holds the platform-free part of the virtualized list/grid control: viewport and
+ * scroll math, column layout, hit testing and a small ring of recycled row caches. Every operation
+ * only touches the visible window of rows, so its cost doesn't depend on the dataset size
+ */
+class VirtualList {
+public:
+    explicit VirtualList(RowProvider *provider = nullptr, int rowHeight = 24);
+
+    void SetProvider(RowProvider *newProvider);
+    void SetColumns(std::vector<int> widths);
+    void SetViewport(int width, int height);
+    void InvalidateRows();
+
+    ScrollResult ScrollTo(std::size_t row);
+    ScrollResult ScrollBy(std::int64_t rows);
+
+    [[nodiscard]] const std::vector<std::wstring> &RowAt(std::size_t row);
+
+    [[nodiscard]] RowRange VisibleRows() const;
+    [[nodiscard]] RowRange RowsInBand(int top, int bottom) const;
+    [[nodiscard]] CellHit HitTest(int x, int y) const;
+    [[nodiscard]] int RowTop(std::size_t row) const;
+    [[nodiscard]] int ColumnLeft(std::size_t column) const;
+    [[nodiscard]] int ColumnWidth(std::size_t column) const;
+
+    [[nodiscard]] std::size_t RowCount() const;
+    [[nodiscard]] std::size_t ColumnCount() const;
+    [[nodiscard]] std::size_t TopRow() const;
+    [[nodiscard]] std::size_t MaxTopRow() const;
+    [[nodiscard]] std::size_t PageRows() const;
+    [[nodiscard]] int RowHeight() const;
+    [[nodiscard]] int ViewportWidth() const;
+    [[nodiscard]] int ViewportHeight() const;
+
+private:
+    static constexpr std::size_t kNoRow = static_cast<std::size_t>(-1);
+
+    struct RowSlot {
+        std::size_t row = kNoRow;
+        std::vector<std::wstring> cells;
+    };
+
+    void ResizeCache();
+
+    RowProvider *provider = nullptr;
+
+    int rowHeight = 24;
+    int viewportWidth = 0, viewportHeight = 0;
+    std::size_t topRow = 0;
+
+    std::vector<int> columnWidths;
+    std::vector<int> columnLefts;
+
+    // Slot 'row % size' caches that row, sized so no two visible rows share a slot
+    std::vector<RowSlot> cache;
+};
@@ -0,0 +1,63 @@
+#pragma once
+#include <Windows.h>
+#include <cstddef>
+#include <vector>
+
+#include "app/VirtualList.h"
+
+/**
+ * VirtualListView is the Win32 side of the virtualized list/grid, a single owner-drawn child window
+ * that paints only the rows intersecting the invalid region and scrolls by blitting with ScrollWindowEx,
+ * one HWND, font and pair of brushes are shared by every row regardless of the dataset size
+ */
+class VirtualListView {
+public:
+    VirtualListView(HWND parentHwnd,
+                    HINSTANCE hInstance,
+                    int x, int y,
+                    int width, int height,
+                    RowProvider *provider,
+                    int rowHeight,
+                    COLORREF bgColor,
+                    COLORREF textColor,
+                    COLORREF gridColor,
+                    int fontSize,
+                    LPCWSTR fontFamily,
+                    HMENU controlId);
+
+    ~VirtualListView();
+
+    VirtualListView(const VirtualListView&) = delete;
+    VirtualListView& operator=(const VirtualListView&) = delete;
+    VirtualListView(VirtualListView&&) = delete;
+    VirtualListView& operator=(VirtualListView&&) = delete;
+
+    void SetSizeAndPosition(int x, int y, int width, int height);
+    void SetColumns(std::vector<int> widths);
+    void SetColors(COLORREF newBgColor, COLORREF newTextColor, COLORREF newGridColor);
+    void ScrollToRow(std::size_t row);
+    void Refresh();
+
+    [[nodiscard]] HWND GetHwnd() const;
+    [[nodiscard]] std::size_t GetTopRow() const;
+
+private:
+    static LRESULT CALLBACK ListWindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+
+    void Paint(HDC hdc, const RECT &dirty);
+    void ApplyScroll(const ScrollResult &result);
+    void UpdateScrollBar();
+    void OnVScroll(int request);
+
+    [[nodiscard]] std::size_t ScrollScale() const;
+
+    VirtualList model;
+
+    HWND   hList     = nullptr;
+    HFONT  hFont     = nullptr;
+    HBRUSH bgBrush   = nullptr;
+    HBRUSH gridBrush = nullptr;
+
+    COLORREF textColor = 0;
+    int wheelRemainder = 0;
+};
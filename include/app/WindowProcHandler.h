@@ -5,4 +5,5 @@ class WindowProcHandler {
 public:
     static LRESULT CALLBACK ChildWindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
     static LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+    static void ApplyTitleBarTheme(HWND hwnd, COLORREF background);
 };
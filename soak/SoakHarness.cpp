@@ -0,0 +1,516 @@
+#include <Windows.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "app/AppState.h"
+#include "app/MainWindow.h"
+#include "app/StateStore.h"
+#include "app/Theme.h"
+#include "app/ThemeEngine.h"
+#include "app/TimerWheel.h"
+#include "app/VirtualListView.h"
+#include "headless/HeadlessBackend.h"
+
+// Live heap bytes, every allocation carries a header holding its size so frees can be subtracted
+namespace {
+    constexpr std::size_t kHeapHeader = alignof(std::max_align_t);
+
+    std::atomic<std::int64_t> gLiveBytes{0};
+    std::atomic<std::int64_t> gLiveBlocks{0};
+}
+
+void *operator new(std::size_t size) {
+    auto *block = static_cast<unsigned char *>(std::malloc(size + kHeapHeader));
+    if (!block) throw std::bad_alloc();
+
+    std::memcpy(block, &size, sizeof(size));
+    gLiveBytes.fetch_add(static_cast<std::int64_t>(size), std::memory_order_relaxed);
+    gLiveBlocks.fetch_add(1, std::memory_order_relaxed);
+    return block + kHeapHeader;
+}
+
+void operator delete(void *ptr) noexcept {
+    if (!ptr) return;
+
+    auto *block = static_cast<unsigned char *>(ptr) - kHeapHeader;
+    std::size_t size;
+    std::memcpy(&size, block, sizeof(size));
+    gLiveBytes.fetch_sub(static_cast<std::int64_t>(size), std::memory_order_relaxed);
+    gLiveBlocks.fetch_sub(1, std::memory_order_relaxed);
+    std::free(block);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+    operator delete(ptr);
+}
+
+namespace {
+    using SoakClock = std::chrono::steady_clock;
+
+    // Parent size every canonical state is measured at
+    constexpr int kInitialWidth = 1280;
+    constexpr int kInitialHeight = 720;
+
+    // Control ids the window procs dispatch on, same values as main and WindowProcHandler
+    constexpr int kBtnClickId = 1;
+    constexpr int kBtnRandomId = 2;
+    constexpr int kChildOkId = 1001;
+
+    constexpr std::uint64_t kHeartbeatMs = 1;
+
+    struct Config {
+        std::uint64_t events = 2'000'000;
+        std::uint32_t seed = 0xC0FFEE;
+        std::size_t epochs = 20;
+        std::size_t warmupEpochs = 2;
+
+        // Late p99 may grow by this ratio over the early p99, plus a fixed slack for timer noise
+        double maxP99Drift = 3.0;
+        double p99SlackNs = 5'000.0;
+
+        // Live heap may grow by this much between the first and any later canonical state
+        std::int64_t maxHeapGrowth = 64 * 1024;
+    };
+
+    /**
+     * Latency histogram with 8 linear sub-buckets per power of two, recording costs
+     * a couple of shifts and percentiles are accurate to within 12.5%
+     */
+    class LatencyHistogram {
+    public:
+        void Record(std::uint64_t ns) {
+            ++counts[Bucket(ns)];
+            ++total;
+            maxNs = std::max(maxNs, ns);
+        }
+
+        [[nodiscard]] double Percentile(double q) const {
+            if (!total) return 0.0;
+
+            const auto target = static_cast<std::uint64_t>(q * static_cast<double>(total - 1)) + 1;
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < kBuckets; ++i) {
+                seen += counts[i];
+                if (seen >= target) return static_cast<double>(UpperBound(i));
+            }
+            return static_cast<double>(maxNs);
+        }
+
+        [[nodiscard]] std::uint64_t Max() const { return maxNs; }
+
+        void Reset() {
+            counts.fill(0);
+            total = 0;
+            maxNs = 0;
+        }
+
+    private:
+        static constexpr std::size_t kSubBits = 3;
+        static constexpr std::size_t kSub = std::size_t{1} << kSubBits;
+        static constexpr std::size_t kBuckets = 64 * kSub;
+
+        static std::size_t Bucket(std::uint64_t ns) {
+            if (ns < kSub) return static_cast<std::size_t>(ns);
+
+            const auto exponent = static_cast<std::size_t>(63 - std::countl_zero(ns));
+            const auto mantissa = static_cast<std::size_t>((ns >> (exponent - kSubBits)) & (kSub - 1));
+            return (exponent - kSubBits + 1) * kSub + mantissa;
+        }
+
+        static std::uint64_t UpperBound(std::size_t bucket) {
+            if (bucket < kSub) return bucket;
+
+            const std::size_t exponent = bucket / kSub + kSubBits - 1;
+            const std::uint64_t mantissa = bucket % kSub;
+            return ((kSub + mantissa + 1) << (exponent - kSubBits)) - 1;
+        }
+
+        std::array<std::uint64_t, kBuckets> counts{};
+        std::uint64_t total = 0;
+        std::uint64_t maxNs = 0;
+    };
+
+    // Everything measured once the app has been brought back to the canonical state
+    struct Snapshot {
+        headless::HandleCounts handles;
+        std::size_t themeControls = 0;
+        std::int64_t heapBytes = 0;
+        std::int64_t heapBlocks = 0;
+    };
+
+    struct EpochReport {
+        double p50 = 0.0;
+        double p99 = 0.0;
+        double p999 = 0.0;
+        std::uint64_t max = 0;
+        Snapshot snapshot;
+    };
+
+    /**
+     * Mirrors the objects WinMain keeps alive, declared in the same order so teardown happens
+     * in the same order: the main window first, then the change bus, theme engine and timer wheel
+     */
+    struct App {
+        TimerWheel timers{GetTickCount64()};
+        ThemeEngine theme{kDefaultTheme};
+        ChangeBus changes;
+        std::unique_ptr<MainWindow> window;
+        HWND hwnd = nullptr;
+
+        // Stands in for main's theme file poll, keeps a deadline pending for the loop and modal WM_TIMERs to fire
+        std::function<void()> heartbeat = [this] { timers.Schedule(kHeartbeatMs, heartbeat); };
+
+        [[nodiscard]] AppState *State() const {
+            return reinterpret_cast<AppState *>(GetWindowLongPtrW(hwnd, GWLP_USERDATA));
+        }
+
+        [[nodiscard]] HWND List() const {
+            const AppState *state = State();
+            return state && state->list ? state->list->GetHwnd() : nullptr;
+        }
+
+        [[nodiscard]] HWND Child() const {
+            const AppState *state = State();
+            HWND child = state ? state->childHwnd.Get() : nullptr;
+            return child && IsWindow(child) ? child : nullptr;
+        }
+
+        // One message loop iteration's worth of follow-up work, flushed before painting like main's WM_PAINT dispatch
+        void Settle() {
+            timers.Advance(GetTickCount64());
+            changes.Flush();
+            headless::PumpPaints();
+        }
+    };
+
+    // Same setup WinMain runs before its message loop, only the theme file watcher is left out
+    std::unique_ptr<App> CreateApp() {
+        auto app = std::make_unique<App>();
+        app->window = std::make_unique<MainWindow>(GetModuleHandleW(nullptr), app->timers, app->theme, app->changes);
+        app->hwnd = app->window->GetHwnd();
+        if (!app->hwnd) return nullptr;
+
+        app->heartbeat();
+
+        headless::PumpPaints();
+        return app;
+    }
+
+    // Confirms the close dialog, the parent destroys itself and posts the quit WinMain would return on
+    void DestroyApp(std::unique_ptr<App> &app) {
+        headless::SetMessageBoxResult(IDYES);
+        SendMessageW(app->hwnd, WM_CLOSE, 0, 0);
+        headless::SetMessageBoxResult(IDNO);
+
+        app.reset();
+        headless::ClearQuit();
+    }
+
+    void Click(HWND hwnd, int id) {
+        SendMessageW(hwnd, WM_COMMAND, MAKEWPARAM(id, 0), 0);
+    }
+
+    /**
+     * Randomized event generator, every step is one message loop iteration: one or a burst of
+     * dispatched events, then a single change bus flush and the paints they caused. Bursts are what
+     * coalesce several writes into one batch, including a child closed and reopened before the flush
+     */
+    class EventDriver {
+    public:
+        EventDriver(const Config &config, std::unique_ptr<App> &app) : app(app), gen(config.seed) {}
+
+        void Step() {
+            const int roll = perMille(gen);
+
+            if (roll < 50) {
+                // Close and reopen within one batch, the child handle changes twice before the flush
+                if (HWND child = app->Child()) Click(child, kChildOkId);
+                Click(app->hwnd, kBtnClickId);
+            } else {
+                const int events = roll < 300 ? burst(gen) : 1;
+                for (int i = 0; i < events; ++i) {
+                    if (!Dispatch()) return;
+                }
+            }
+
+            app->Settle();
+        }
+
+        [[nodiscard]] std::uint64_t Recreated() const { return recreated; }
+
+    private:
+        // Sends one random event without flushing, returns false when it recreated the app instead
+        bool Dispatch() {
+            // Weights are per mille, close-confirm is rare since it tears the whole app down
+            const int roll = perMille(gen);
+            App &a = *app;
+
+            if (roll < 200) {
+                Click(a.hwnd, kBtnClickId);
+            } else if (roll < 360) {
+                Click(a.hwnd, kBtnRandomId);
+            } else if (roll < 500) {
+                if (HWND child = a.Child()) Click(child, kChildOkId);
+            } else if (roll < 550) {
+                if (HWND child = a.Child()) ShowWindow(child, SW_MINIMIZE);
+            } else if (roll < 690) {
+                Resize(a.hwnd, a, 200, 1920, 150, 1080);
+            } else if (roll < 760) {
+                if (HWND child = a.Child()) Resize(child, a, 120, 900, 90, 600);
+            } else if (roll < 860) {
+                if (HWND list = a.List()) Scroll(list);
+            } else if (roll < 920) {
+                SendMessageW(a.hwnd, WM_CLOSE, 0, 0);
+            } else if (roll < 999) {
+                a.theme.Apply(kBuiltInThemes[theme(gen)].table);
+            } else if (closeConfirm(gen) == 0) {
+                ++recreated;
+                DestroyApp(app);
+                app = CreateApp();
+                return false;
+            }
+
+            return true;
+        }
+
+        // Plain resize, or a live drag that runs the WM_ENTERSIZEMOVE path with a few intermediate sizes
+        void Resize(HWND hwnd, App &a, int minW, int maxW, int minH, int maxH) {
+            std::uniform_int_distribution<int> width(minW, maxW);
+            std::uniform_int_distribution<int> height(minH, maxH);
+
+            if (perMille(gen) < 500) {
+                SetWindowPos(hwnd, nullptr, 0, 0, width(gen), height(gen), SWP_NOZORDER);
+                return;
+            }
+
+            SendMessageW(hwnd, WM_ENTERSIZEMOVE, 0, 0);
+            const int steps = 1 + perMille(gen) % 6;
+            for (int i = 0; i < steps; ++i) {
+                SetWindowPos(hwnd, nullptr, 0, 0, width(gen), height(gen), SWP_NOZORDER);
+                headless::FireTimers();
+                headless::PumpPaints();
+            }
+            SendMessageW(hwnd, WM_EXITSIZEMOVE, 0, 0);
+            a.Settle();
+        }
+
+        // Wheel (including high resolution deltas), keyboard, scroll bar and thumb drags on the colour list
+        void Scroll(HWND list) {
+            static constexpr std::array<WPARAM, 6> kKeys{VK_UP, VK_DOWN, VK_PRIOR, VK_NEXT, VK_HOME, VK_END};
+            const int roll = perMille(gen);
+
+            if (roll < 350) {
+                const int delta = (perMille(gen) % 7 - 3) * WHEEL_DELTA / 3;
+                SendMessageW(list, WM_MOUSEWHEEL, MAKEWPARAM(0, delta), 0);
+            } else if (roll < 600) {
+                SendMessageW(list, WM_KEYDOWN, kKeys[static_cast<std::size_t>(perMille(gen)) % kKeys.size()], 0);
+            } else if (roll < 850) {
+                SendMessageW(list, WM_VSCROLL, MAKEWPARAM(perMille(gen) % (SB_BOTTOM + 1), 0), 0);
+            } else if (roll < 950) {
+                SCROLLINFO si{};
+                si.cbSize = sizeof(si);
+                si.fMask = SIF_RANGE;
+                GetScrollInfo(list, SB_VERT, &si);
+                headless::DragScrollThumb(list, std::uniform_int_distribution<int>(si.nMin, si.nMax)(gen));
+            } else {
+                SendMessageW(list, WM_LBUTTONDOWN, 0, 0);
+            }
+        }
+
+        std::unique_ptr<App> &app;
+        std::mt19937 gen;
+        std::uniform_int_distribution<int> perMille{0, 999};
+        std::uniform_int_distribution<int> burst{2, 8};
+        std::uniform_int_distribution<std::size_t> theme{0, kBuiltInThemes.size() - 1};
+        std::uniform_int_distribution<int> closeConfirm{0, 9};
+        std::uint64_t recreated = 0;
+    };
+
+    /**
+     * Brings the app to a fixed state before measuring, the child is opened and closed so the
+     * label font it caches exists no matter what the previous events did, and the list is back at the top
+     */
+    Snapshot Canonicalize(App &app) {
+        if (!app.Child()) {
+            Click(app.hwnd, kBtnClickId);
+            app.Settle();
+        }
+        if (HWND child = app.Child()) Click(child, kChildOkId);
+        app.Settle();
+
+        SetWindowPos(app.hwnd, nullptr, 0, 0, kInitialWidth, kInitialHeight, SWP_NOZORDER);
+        if (HWND list = app.List()) SendMessageW(list, WM_KEYDOWN, VK_HOME, 0);
+        app.theme.Apply(kDefaultTheme);
+        app.Settle();
+
+        Snapshot snapshot;
+        snapshot.handles = headless::Counts();
+        snapshot.themeControls = app.theme.ControlCount();
+        snapshot.heapBytes = gLiveBytes.load(std::memory_order_relaxed);
+        snapshot.heapBlocks = gLiveBlocks.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+    bool SameHandles(const Snapshot &a, const Snapshot &b) {
+        return a.handles.windows == b.handles.windows && a.handles.brushes == b.handles.brushes &&
+               a.handles.fonts == b.handles.fonts && a.handles.dcs == b.handles.dcs &&
+               a.handles.timers == b.handles.timers && a.themeControls == b.themeControls;
+    }
+
+    double MedianP99(std::vector<EpochReport>::const_iterator first, std::vector<EpochReport>::const_iterator last) {
+        std::vector<double> values;
+        for (auto it = first; it != last; ++it) values.push_back(it->p99);
+        if (values.empty()) return 0.0;
+
+        std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(values.size() / 2), values.end());
+        return values[values.size() / 2];
+    }
+
+    bool ParseArgs(int argc, char **argv, Config &config) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg = argv[i];
+            if (i + 1 >= argc) {
+                std::fprintf(stderr, "missing value for %s\n", argv[i]);
+                return false;
+            }
+
+            const char *value = argv[++i];
+            if (arg == "--events") config.events = std::strtoull(value, nullptr, 10);
+            else if (arg == "--seed") config.seed = static_cast<std::uint32_t>(std::strtoul(value, nullptr, 0));
+            else if (arg == "--epochs") config.epochs = std::strtoull(value, nullptr, 10);
+            else if (arg == "--warmup") config.warmupEpochs = std::strtoull(value, nullptr, 10);
+            else if (arg == "--max-p99-drift") config.maxP99Drift = std::strtod(value, nullptr);
+            else if (arg == "--max-heap-growth") config.maxHeapGrowth = std::strtoll(value, nullptr, 10);
+            else {
+                std::fprintf(stderr, "unknown option %s\n", argv[i - 1]);
+                return false;
+            }
+        }
+
+        if (config.epochs < config.warmupEpochs + 2 || config.events < config.epochs) {
+            std::fprintf(stderr, "need at least warmup + 2 epochs and one event per epoch\n");
+            return false;
+        }
+        return true;
+    }
+}
+
+/**
+ * Soak harness, drives the real window procs through millions of randomized events on the headless
+ * Win32 stand-in. Each epoch reports dispatch latency percentiles, live heap and handle counts taken
+ * at a canonical state, and the run fails when any of them drifts past its threshold
+ */
+int main(int argc, char **argv) {
+    Config config;
+    if (!ParseArgs(argc, argv, config)) return 2;
+
+    if (!MainWindow::RegisterWindowClass(GetModuleHandleW(nullptr))) return 2;
+
+    headless::SetMessageBoxResult(IDNO);
+    std::unique_ptr<App> app = CreateApp();
+    if (!app) {
+        std::fprintf(stderr, "failed to create the parent window\n");
+        return 2;
+    }
+
+    EventDriver driver(config, app);
+    LatencyHistogram histogram;
+    std::vector<EpochReport> reports;
+    reports.reserve(config.epochs);
+    const std::uint64_t perEpoch = config.events / config.epochs;
+
+    std::printf("seed 0x%X, %llu events in %zu epochs (%zu warm-up)\n\n", config.seed,
+                static_cast<unsigned long long>(perEpoch * config.epochs), config.epochs, config.warmupEpochs);
+    std::printf("%-6s %10s %10s %10s %10s %12s %8s %8s %6s %6s %4s %6s %8s\n",
+                "epoch", "p50 ns", "p99 ns", "p999 ns", "max ns", "heap B", "blocks",
+                "windows", "brush", "font", "dc", "timer", "themed");
+
+    for (std::size_t epoch = 0; epoch < config.epochs; ++epoch) {
+        histogram.Reset();
+        for (std::uint64_t i = 0; i < perEpoch; ++i) {
+            const auto start = SoakClock::now();
+            driver.Step();
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(SoakClock::now() - start);
+            histogram.Record(static_cast<std::uint64_t>(elapsed.count()));
+        }
+
+        EpochReport report;
+        report.p50 = histogram.Percentile(0.50);
+        report.p99 = histogram.Percentile(0.99);
+        report.p999 = histogram.Percentile(0.999);
+        report.max = histogram.Max();
+        report.snapshot = Canonicalize(*app);
+        reports.push_back(report);
+
+        const Snapshot &s = report.snapshot;
+        std::printf("%-6zu %10.0f %10.0f %10.0f %10llu %12lld %8lld %8zu %6zu %6zu %4zu %6zu %8zu%s\n",
+                    epoch, report.p50, report.p99, report.p999, static_cast<unsigned long long>(report.max),
+                    static_cast<long long>(s.heapBytes), static_cast<long long>(s.heapBlocks),
+                    s.handles.windows, s.handles.brushes, s.handles.fonts, s.handles.dcs, s.handles.timers,
+                    s.themeControls,
+                    epoch < config.warmupEpochs ? "  (warm-up)" : "");
+    }
+
+    // Drift checks compare the measured epochs against the first one after warm-up
+    const auto measured = reports.cbegin() + static_cast<std::ptrdiff_t>(config.warmupEpochs);
+    const Snapshot &baseline = measured->snapshot;
+    bool failed = false;
+
+    for (auto it = measured; it != reports.cend(); ++it) {
+        const auto epoch = static_cast<std::size_t>(it - reports.cbegin());
+        if (!SameHandles(it->snapshot, baseline)) {
+            std::printf("FAIL: epoch %zu handle counts differ from epoch %zu\n", epoch, config.warmupEpochs);
+            failed = true;
+        }
+
+        const std::int64_t growth = it->snapshot.heapBytes - baseline.heapBytes;
+        if (growth > config.maxHeapGrowth) {
+            std::printf("FAIL: epoch %zu heap grew %lld bytes, limit %lld\n", epoch,
+                        static_cast<long long>(growth), static_cast<long long>(config.maxHeapGrowth));
+            failed = true;
+        }
+    }
+
+    // Median of a few epochs on each end so a single noisy epoch neither passes nor fails the run
+    const std::size_t window = std::min<std::size_t>(3, (reports.cend() - measured) / 2);
+    const double earlyP99 = MedianP99(measured, measured + static_cast<std::ptrdiff_t>(window));
+    const double lateP99 = MedianP99(reports.cend() - static_cast<std::ptrdiff_t>(window), reports.cend());
+    const double p99Limit = earlyP99 * config.maxP99Drift + config.p99SlackNs;
+    if (lateP99 > p99Limit) {
+        std::printf("FAIL: p99 drifted from %.0f ns to %.0f ns, limit %.0f ns\n", earlyP99, lateP99, p99Limit);
+        failed = true;
+    }
+
+    DestroyApp(app);
+    MainWindow::UnregisterWindowClass(GetModuleHandleW(nullptr));
+
+    // With every window gone nothing may be left behind, and no call may have used a dead handle
+    const headless::HandleCounts leftover = headless::Counts();
+    if (leftover.windows || leftover.brushes || leftover.fonts || leftover.dcs || leftover.timers) {
+        std::printf("FAIL: %zu windows, %zu brushes, %zu fonts, %zu DCs, %zu timers left after teardown\n",
+                    leftover.windows, leftover.brushes, leftover.fonts, leftover.dcs, leftover.timers);
+        failed = true;
+    }
+    if (leftover.invalidUses) {
+        std::printf("FAIL: %zu calls used a destroyed or unknown handle\n", leftover.invalidUses);
+        failed = true;
+    }
+
+    std::printf("\np99 early %.0f ns, late %.0f ns, app recreated %llu times: %s\n", earlyP99, lateP99,
+                static_cast<unsigned long long>(driver.Recreated()), failed ? "FAILED" : "ok");
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+
+#include <Windows.h>
+
+/**
+ * Introspection and scripting hooks of the headless Win32 stand-in, used by the soak harness
+ * to answer dialogs, deliver pending paints and read live handle counts
+ */
+namespace headless {
+    struct HandleCounts {
+        std::size_t windows = 0;
+        std::size_t brushes = 0;
+        std::size_t fonts = 0;
+        std::size_t dcs = 0;
+        std::size_t timers = 0;
+
+        // Calls made with a destroyed or unknown handle, always a bug in the caller
+        std::size_t invalidUses = 0;
+    };
+
+    [[nodiscard]] HandleCounts Counts();
+
+    // Answer returned by every following MessageBoxW call, each call also fires armed timers once
+    void SetMessageBoxResult(int result);
+
+    // Delivers one WM_TIMER to every armed timer, as a modal loop would once their period elapsed
+    std::size_t FireTimers();
+
+    // Drags the vertical scroll bar thumb to 'position' and sends the SB_THUMBTRACK a real drag would
+    BOOL DragScrollThumb(HWND hwnd, int position);
+
+    // Paints every invalidated window the way the message loop would, returns messages delivered
+    std::size_t PumpPaints();
+
+    [[nodiscard]] bool QuitPosted();
+    void ClearQuit();
+}
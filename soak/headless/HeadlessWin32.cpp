@@ -0,0 +1,729 @@
+#include <Windows.h>
+#include <dwmapi.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "HeadlessBackend.h"
+
+namespace {
+    constexpr int kScreenWidth = 1920;
+    constexpr int kScreenHeight = 1080;
+    constexpr int kDefaultWidth = 1280;
+    constexpr int kDefaultHeight = 720;
+
+    // Stock objects live below every allocated handle and are never counted or freed
+    constexpr std::uintptr_t kStockBase = 0x100;
+    constexpr std::uintptr_t kStockEnd = 0x200;
+    constexpr std::uintptr_t kFirstHandle = 0x1000;
+
+    constexpr UINT kOdtButton = 4;
+    constexpr UINT kOdaDrawEntire = 1;
+    constexpr DWORD kButtonTypeMask = 0x0000000FL;
+
+    // Bounded so a window that invalidates itself while painting can't hang the harness
+    constexpr int kMaxPaintPasses = 8;
+
+    struct Window {
+        std::wstring className;
+        WNDPROC proc = nullptr;
+        LONG_PTR userData = 0;
+        HWND parent = nullptr;
+        int id = 0;
+        DWORD style = 0;
+        int x = 0, y = 0, width = 0, height = 0;
+        bool visible = false;
+        bool iconic = false;
+        bool dirty = false;
+        bool erase = false;
+        bool destroying = false;
+        HGDIOBJ font = nullptr;
+
+        // Vertical scroll bar, the thumb drag position lives in 'nTrackPos'
+        SCROLLINFO scroll{};
+    };
+
+    enum class GdiKind { Brush, Font };
+
+    struct GdiObject {
+        GdiKind kind = GdiKind::Brush;
+        int height = 0;
+    };
+
+    struct Backend {
+        std::unordered_map<std::uintptr_t, Window> windows;
+        std::unordered_map<std::uintptr_t, GdiObject> objects;
+        std::unordered_map<std::uintptr_t, HGDIOBJ> dcs;
+        std::unordered_map<std::wstring, WNDPROC> classes;
+
+        // Armed timers in the order they were set, so delivery is deterministic
+        std::vector<std::pair<HWND, UINT_PTR>> timers;
+
+        std::uintptr_t nextHandle = kFirstHandle;
+        HWND foreground = nullptr;
+        HWND focus = nullptr;
+        int messageBoxResult = IDNO;
+        bool quit = false;
+        std::size_t invalidUses = 0;
+    };
+
+    Backend &State() {
+        static Backend backend;
+        return backend;
+    }
+
+    std::uintptr_t Key(const void *handle) {
+        return reinterpret_cast<std::uintptr_t>(handle);
+    }
+
+    std::uintptr_t NewHandle() {
+        return State().nextHandle++;
+    }
+
+    bool IsStock(HGDIOBJ object) {
+        return Key(object) >= kStockBase && Key(object) < kStockEnd;
+    }
+
+    Window *Find(HWND hwnd) {
+        auto &windows = State().windows;
+        const auto it = windows.find(Key(hwnd));
+        return it == windows.end() ? nullptr : &it->second;
+    }
+
+    Window *FindOrFlag(HWND hwnd) {
+        Window *window = Find(hwnd);
+        if (!window) ++State().invalidUses;
+        return window;
+    }
+
+    bool CheckDc(HDC hdc) {
+        if (State().dcs.contains(Key(hdc))) return true;
+        ++State().invalidUses;
+        return false;
+    }
+
+    bool CheckObject(HGDIOBJ object) {
+        if (IsStock(object) || State().objects.contains(Key(object))) return true;
+        ++State().invalidUses;
+        return false;
+    }
+
+    HDC NewDc() {
+        const std::uintptr_t handle = NewHandle();
+        State().dcs.emplace(handle, GetStockObject(DEFAULT_GUI_FONT));
+        return reinterpret_cast<HDC>(handle);
+    }
+
+    void FreeDc(HDC hdc) {
+        if (State().dcs.erase(Key(hdc)) == 0) ++State().invalidUses;
+    }
+
+    std::vector<HWND> ChildrenOf(HWND parent) {
+        std::vector<HWND> children;
+        for (const auto &[handle, window] : State().windows) {
+            if (window.parent == parent) children.push_back(reinterpret_cast<HWND>(handle));
+        }
+        std::sort(children.begin(), children.end());
+        return children;
+    }
+
+    void MarkDirty(HWND hwnd, bool erase, bool allChildren) {
+        Window *window = Find(hwnd);
+        if (!window) return;
+
+        window->dirty = true;
+        window->erase |= erase;
+
+        // Without WS_CLIPCHILDREN the parent paints over its children, so they repaint too
+        if (allChildren || !(window->style & WS_CLIPCHILDREN)) {
+            for (HWND child : ChildrenOf(hwnd)) MarkDirty(child, erase, allChildren);
+        }
+    }
+
+    // Built-in BUTTON and STATIC controls only need to remember their font
+    LRESULT CALLBACK ControlProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
+        switch (uMsg) {
+            case WM_SETFONT:
+                if (Window *window = Find(hwnd)) {
+                    window->font = reinterpret_cast<HGDIOBJ>(wParam);
+                    if (lParam) window->dirty = true;
+                }
+                return 0;
+
+            case WM_GETFONT: {
+                const Window *window = Find(hwnd);
+                return window ? reinterpret_cast<LRESULT>(window->font) : 0;
+            }
+
+            default:
+                return DefWindowProcW(hwnd, uMsg, wParam, lParam);
+        }
+    }
+
+    // Reproduces what a real control's WM_PAINT would ask its parent for
+    void PaintWindow(HWND hwnd) {
+        Window *window = Find(hwnd);
+        if (!window) return;
+
+        if (window->className == L"BUTTON") {
+            window->dirty = false;
+            window->erase = false;
+            if ((window->style & kButtonTypeMask) != BS_OWNERDRAW || !window->parent) return;
+
+            HDC hdc = NewDc();
+            DRAWITEMSTRUCT dis{};
+            dis.CtlType = kOdtButton;
+            dis.CtlID = static_cast<UINT>(window->id);
+            dis.itemAction = kOdaDrawEntire;
+            dis.hwndItem = hwnd;
+            dis.hDC = hdc;
+            dis.rcItem = {0, 0, window->width, window->height};
+
+            SendMessageW(window->parent, WM_DRAWITEM, static_cast<WPARAM>(window->id), reinterpret_cast<LPARAM>(&dis));
+            FreeDc(hdc);
+            return;
+        }
+
+        if (window->className == L"STATIC") {
+            window->dirty = false;
+            window->erase = false;
+            if (!window->parent) return;
+
+            HDC hdc = NewDc();
+            const LRESULT brush = SendMessageW(window->parent, WM_CTLCOLORSTATIC,
+                                               reinterpret_cast<WPARAM>(hdc), reinterpret_cast<LPARAM>(hwnd));
+            if (brush) CheckObject(reinterpret_cast<HGDIOBJ>(brush));
+            FreeDc(hdc);
+            return;
+        }
+
+        SendMessageW(hwnd, WM_PAINT, 0, 0);
+
+        // DefWindowProc validates a window whose proc never called BeginPaint
+        if (Window *painted = Find(hwnd)) {
+            painted->dirty = false;
+            painted->erase = false;
+        }
+    }
+}
+
+namespace headless {
+    HandleCounts Counts() {
+        HandleCounts counts;
+        counts.windows = State().windows.size();
+        counts.dcs = State().dcs.size();
+        counts.timers = State().timers.size();
+        counts.invalidUses = State().invalidUses;
+
+        for (const auto &[handle, object] : State().objects) {
+            if (object.kind == GdiKind::Brush) ++counts.brushes;
+            else ++counts.fonts;
+        }
+        return counts;
+    }
+
+    void SetMessageBoxResult(int result) {
+        State().messageBoxResult = result;
+    }
+
+    std::size_t FireTimers() {
+        // Copied, handlers may set or kill timers while they are being delivered
+        const auto armed = State().timers;
+
+        std::size_t delivered = 0;
+        for (const auto &[hwnd, id] : armed) {
+            const auto &timers = State().timers;
+            if (std::find(timers.begin(), timers.end(), std::make_pair(hwnd, id)) == timers.end()) continue;
+
+            SendMessageW(hwnd, WM_TIMER, id, 0);
+            ++delivered;
+        }
+        return delivered;
+    }
+
+    std::size_t PumpPaints() {
+        std::size_t delivered = 0;
+
+        for (int pass = 0; pass < kMaxPaintPasses; ++pass) {
+            std::vector<HWND> dirty;
+            for (const auto &[handle, window] : State().windows) {
+                if (window.dirty && window.visible) dirty.push_back(reinterpret_cast<HWND>(handle));
+            }
+            if (dirty.empty()) break;
+
+            // Handles grow monotonically, so this paints parents before the controls they created
+            std::sort(dirty.begin(), dirty.end());
+            for (HWND hwnd : dirty) {
+                const Window *window = Find(hwnd);
+                if (!window || !window->dirty) continue;
+                PaintWindow(hwnd);
+                ++delivered;
+            }
+        }
+
+        return delivered;
+    }
+
+    BOOL DragScrollThumb(HWND hwnd, int position) {
+        Window *window = FindOrFlag(hwnd);
+        if (!window) return FALSE;
+
+        window->scroll.nTrackPos = std::clamp(position, window->scroll.nMin, window->scroll.nMax);
+        SendMessageW(hwnd, WM_VSCROLL, MAKEWPARAM(SB_THUMBTRACK, 0), 0);
+        return TRUE;
+    }
+
+    bool QuitPosted() { return State().quit; }
+    void ClearQuit() { State().quit = false; }
+}
+
+LRESULT DefWindowProcW(HWND hwnd, UINT uMsg, WPARAM, LPARAM) {
+    switch (uMsg) {
+        case WM_NCCREATE:
+            return TRUE;
+        case WM_CLOSE:
+            DestroyWindow(hwnd);
+            return 0;
+        default:
+            return 0;
+    }
+}
+
+LRESULT SendMessageW(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
+    const Window *window = FindOrFlag(hwnd);
+    if (!window) return 0;
+
+    const WNDPROC proc = window->proc;
+    return proc(hwnd, uMsg, wParam, lParam);
+}
+
+unsigned short RegisterClassW(const WNDCLASSW *wndClass) {
+    if (!wndClass || !wndClass->lpszClassName || !wndClass->lpfnWndProc) return 0;
+
+    const auto [it, inserted] = State().classes.emplace(wndClass->lpszClassName, wndClass->lpfnWndProc);
+    return inserted ? 1 : 0;
+}
+
+BOOL UnregisterClassW(LPCWSTR className, HINSTANCE) {
+    return State().classes.erase(className) ? TRUE : FALSE;
+}
+
+HWND CreateWindowExW(DWORD, LPCWSTR className, LPCWSTR windowName, DWORD style,
+                     int x, int y, int width, int height,
+                     HWND parent, HMENU menu, HINSTANCE hInstance, LPVOID param) {
+    Window window;
+    window.className = className;
+
+    if (window.className == L"BUTTON" || window.className == L"STATIC") {
+        window.proc = ControlProc;
+    } else {
+        const auto it = State().classes.find(window.className);
+        if (it == State().classes.end()) return nullptr;
+        window.proc = it->second;
+    }
+
+    if (parent && !Find(parent)) {
+        ++State().invalidUses;
+        return nullptr;
+    }
+
+    window.parent = parent;
+    window.id = (style & WS_CHILD) ? static_cast<int>(reinterpret_cast<INT_PTR>(menu)) : 0;
+    window.style = style;
+    window.x = x == CW_USEDEFAULT ? 0 : x;
+    window.y = y == CW_USEDEFAULT ? 0 : y;
+    window.width = width == CW_USEDEFAULT ? kDefaultWidth : width;
+    window.height = height == CW_USEDEFAULT ? kDefaultHeight : height;
+    window.visible = (style & WS_VISIBLE) != 0;
+    window.dirty = window.visible;
+    window.erase = window.visible;
+
+    const std::uintptr_t handle = NewHandle();
+    auto *hwnd = reinterpret_cast<HWND>(handle);
+    State().windows.emplace(handle, std::move(window));
+
+    CREATESTRUCTW cs{};
+    cs.lpCreateParams = param;
+    cs.hInstance = hInstance;
+    cs.hMenu = menu;
+    cs.hwndParent = parent;
+    cs.cx = width;
+    cs.cy = height;
+    cs.x = x;
+    cs.y = y;
+    cs.style = static_cast<LONG>(style);
+    cs.lpszName = windowName;
+    cs.lpszClass = className;
+
+    if (!SendMessageW(hwnd, WM_NCCREATE, 0, reinterpret_cast<LPARAM>(&cs))) {
+        DestroyWindow(hwnd);
+        return nullptr;
+    }
+
+    if (SendMessageW(hwnd, WM_CREATE, 0, reinterpret_cast<LPARAM>(&cs)) == -1) {
+        DestroyWindow(hwnd);
+        return nullptr;
+    }
+
+    if (const Window *created = Find(hwnd)) {
+        SendMessageW(hwnd, WM_SIZE, 0, MAKELPARAM(created->width, created->height));
+    }
+
+    return Find(hwnd) ? hwnd : nullptr;
+}
+
+// Same order as Win32: WM_DESTROY, then the children, then WM_NCDESTROY
+BOOL DestroyWindow(HWND hwnd) {
+    Window *window = FindOrFlag(hwnd);
+    if (!window) return FALSE;
+    if (window->destroying) return TRUE;
+
+    window->destroying = true;
+    if (State().foreground == hwnd) State().foreground = nullptr;
+    if (State().focus == hwnd) State().focus = nullptr;
+
+    SendMessageW(hwnd, WM_DESTROY, 0, 0);
+
+    for (HWND child : ChildrenOf(hwnd)) {
+        if (Find(child)) DestroyWindow(child);
+    }
+
+    SendMessageW(hwnd, WM_NCDESTROY, 0, 0);
+    std::erase_if(State().timers, [hwnd](const auto &timer) { return timer.first == hwnd; });
+    State().windows.erase(Key(hwnd));
+    return TRUE;
+}
+
+BOOL IsWindow(HWND hwnd) {
+    return Find(hwnd) != nullptr;
+}
+
+BOOL IsIconic(HWND hwnd) {
+    const Window *window = FindOrFlag(hwnd);
+    return window && window->iconic;
+}
+
+BOOL ShowWindow(HWND hwnd, int cmdShow) {
+    Window *window = FindOrFlag(hwnd);
+    if (!window) return FALSE;
+
+    const BOOL wasVisible = window->visible;
+
+    switch (cmdShow) {
+        case SW_HIDE:
+            window->visible = false;
+            break;
+        case SW_MINIMIZE:
+            window->iconic = true;
+            break;
+        case SW_RESTORE:
+            window->iconic = false;
+            window->visible = true;
+            MarkDirty(hwnd, true, true);
+            break;
+        case SW_MAXIMIZE:
+            window->iconic = false;
+            window->visible = true;
+            SetWindowPos(hwnd, nullptr, 0, 0, kScreenWidth, kScreenHeight, SWP_NOZORDER);
+            break;
+        default:
+            window->visible = true;
+            MarkDirty(hwnd, true, true);
+            break;
+    }
+
+    return wasVisible;
+}
+
+BOOL UpdateWindow(HWND hwnd) {
+    const Window *window = FindOrFlag(hwnd);
+    if (!window) return FALSE;
+
+    if (window->dirty && window->visible) PaintWindow(hwnd);
+    return TRUE;
+}
+
+BOOL SetWindowPos(HWND hwnd, HWND, int x, int y, int cx, int cy, UINT) {
+    Window *window = FindOrFlag(hwnd);
+    if (!window) return FALSE;
+
+    const bool resized = window->width != cx || window->height != cy;
+    window->x = x;
+    window->y = y;
+    window->width = cx;
+    window->height = cy;
+
+    if (resized) {
+        MarkDirty(hwnd, true, false);
+        SendMessageW(hwnd, WM_SIZE, 0, MAKELPARAM(cx, cy));
+    }
+    return TRUE;
+}
+
+BOOL GetClientRect(HWND hwnd, RECT *rect) {
+    const Window *window = FindOrFlag(hwnd);
+    if (!window || !rect) return FALSE;
+
+    *rect = {0, 0, window->width, window->height};
+    return TRUE;
+}
+
+BOOL SetWindowTextW(HWND hwnd, LPCWSTR) {
+    return FindOrFlag(hwnd) ? TRUE : FALSE;
+}
+
+HWND GetDlgItem(HWND parent, int id) {
+    if (!FindOrFlag(parent)) return nullptr;
+
+    for (HWND child : ChildrenOf(parent)) {
+        if (Find(child)->id == id) return child;
+    }
+    return nullptr;
+}
+
+LONG_PTR SetWindowLongPtrW(HWND hwnd, int index, LONG_PTR value) {
+    Window *window = FindOrFlag(hwnd);
+    if (!window || index != GWLP_USERDATA) return 0;
+
+    const LONG_PTR previous = window->userData;
+    window->userData = value;
+    return previous;
+}
+
+LONG_PTR GetWindowLongPtrW(HWND hwnd, int index) {
+    const Window *window = FindOrFlag(hwnd);
+    return window && index == GWLP_USERDATA ? window->userData : 0;
+}
+
+HWND GetForegroundWindow() {
+    return State().foreground;
+}
+
+BOOL SetForegroundWindow(HWND hwnd) {
+    if (!FindOrFlag(hwnd)) return FALSE;
+    State().foreground = hwnd;
+    return TRUE;
+}
+
+BOOL InvalidateRect(HWND hwnd, const RECT *, BOOL erase) {
+    if (!FindOrFlag(hwnd)) return FALSE;
+    MarkDirty(hwnd, erase != FALSE, false);
+    return TRUE;
+}
+
+BOOL RedrawWindow(HWND hwnd, const RECT *, void *, UINT flags) {
+    if (!FindOrFlag(hwnd)) return FALSE;
+    if (flags & RDW_INVALIDATE) {
+        MarkDirty(hwnd, (flags & RDW_ERASE) != 0, (flags & RDW_ALLCHILDREN) != 0);
+    }
+    return TRUE;
+}
+
+int GetSystemMetrics(int index) {
+    switch (index) {
+        case SM_CXSCREEN: return kScreenWidth;
+        case SM_CYSCREEN: return kScreenHeight;
+        default: return 0;
+    }
+}
+
+// The dialog's modal loop runs while it is open, so armed timers get one tick before it is answered
+int MessageBoxW(HWND, LPCWSTR, LPCWSTR, UINT) {
+    headless::FireTimers();
+    return State().messageBoxResult;
+}
+
+void PostQuitMessage(int) {
+    State().quit = true;
+}
+
+HMODULE GetModuleHandleW(LPCWSTR) {
+    return reinterpret_cast<HMODULE>(static_cast<std::uintptr_t>(0x400000));
+}
+
+HANDLE LoadImageW(HINSTANCE, LPCWSTR, UINT, int, int, UINT) {
+    return nullptr;
+}
+
+HCURSOR LoadCursorW(HINSTANCE, LPCWSTR) {
+    return nullptr;
+}
+
+HWND SetFocus(HWND hwnd) {
+    if (hwnd && !FindOrFlag(hwnd)) return nullptr;
+
+    return std::exchange(State().focus, hwnd);
+}
+
+// Same clamping as Win32, the position can't move past the last full page
+int SetScrollInfo(HWND hwnd, int bar, const SCROLLINFO *info, BOOL) {
+    Window *window = FindOrFlag(hwnd);
+    if (!window || !info || bar != SB_VERT) return 0;
+
+    SCROLLINFO &scroll = window->scroll;
+    if (info->fMask & SIF_RANGE) {
+        scroll.nMin = info->nMin;
+        scroll.nMax = std::max(info->nMax, info->nMin);
+    }
+    if (info->fMask & SIF_PAGE) scroll.nPage = info->nPage;
+    if (info->fMask & SIF_POS) scroll.nPos = info->nPos;
+
+    const int span = scroll.nMax - scroll.nMin + 1;
+    const int lastPos = scroll.nMax - static_cast<int>(std::min<UINT>(scroll.nPage, static_cast<UINT>(span))) + 1;
+    scroll.nPos = std::clamp(scroll.nPos, scroll.nMin, std::max(lastPos, scroll.nMin));
+    return scroll.nPos;
+}
+
+BOOL GetScrollInfo(HWND hwnd, int bar, SCROLLINFO *info) {
+    const Window *window = FindOrFlag(hwnd);
+    if (!window || !info || bar != SB_VERT) return FALSE;
+
+    const SCROLLINFO &scroll = window->scroll;
+    if (info->fMask & SIF_RANGE) {
+        info->nMin = scroll.nMin;
+        info->nMax = scroll.nMax;
+    }
+    if (info->fMask & SIF_PAGE) info->nPage = scroll.nPage;
+    if (info->fMask & SIF_POS) info->nPos = scroll.nPos;
+    if (info->fMask & SIF_TRACKPOS) info->nTrackPos = scroll.nTrackPos;
+    return TRUE;
+}
+
+// Nothing is blitted headless, SW_INVALIDATE still leaves the exposed band to the next paint
+int ScrollWindowEx(HWND hwnd, int, int, const RECT *, const RECT *, HRGN, RECT *, UINT flags) {
+    if (!FindOrFlag(hwnd)) return 0;
+    if (flags & SW_INVALIDATE) MarkDirty(hwnd, false, false);
+    return 1;
+}
+
+UINT_PTR SetTimer(HWND hwnd, UINT_PTR id, UINT, TIMERPROC) {
+    if (!FindOrFlag(hwnd)) return 0;
+
+    auto &timers = State().timers;
+    if (std::find(timers.begin(), timers.end(), std::make_pair(hwnd, id)) == timers.end()) {
+        timers.emplace_back(hwnd, id);
+    }
+    return id;
+}
+
+BOOL KillTimer(HWND hwnd, UINT_PTR id) {
+    return std::erase(State().timers, std::make_pair(hwnd, id)) ? TRUE : FALSE;
+}
+
+ULONGLONG GetTickCount64() {
+    const auto elapsed = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<ULONGLONG>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+}
+
+void OutputDebugStringW(LPCWSTR) {}
+void OutputDebugStringA(LPCSTR) {}
+
+HRESULT DwmSetWindowAttribute(HWND hwnd, DWORD, LPCVOID, DWORD) {
+    return FindOrFlag(hwnd) ? S_OK : -1;
+}
+
+HDC BeginPaint(HWND hwnd, PAINTSTRUCT *paint) {
+    Window *window = FindOrFlag(hwnd);
+    if (!window || !paint) return nullptr;
+
+    const bool erase = window->erase;
+    window->dirty = false;
+    window->erase = false;
+
+    *paint = PAINTSTRUCT{};
+    paint->hdc = NewDc();
+    paint->rcPaint = {0, 0, window->width, window->height};
+
+    // BeginPaint sends WM_ERASEBKGND itself, fErase tells the caller whether it still has to erase
+    paint->fErase = erase && !SendMessageW(hwnd, WM_ERASEBKGND, reinterpret_cast<WPARAM>(paint->hdc), 0);
+    return paint->hdc;
+}
+
+BOOL EndPaint(HWND hwnd, const PAINTSTRUCT *paint) {
+    if (!FindOrFlag(hwnd) || !paint) return FALSE;
+    FreeDc(paint->hdc);
+    return TRUE;
+}
+
+HDC GetDC(HWND hwnd) {
+    return FindOrFlag(hwnd) ? NewDc() : nullptr;
+}
+
+int ReleaseDC(HWND, HDC hdc) {
+    if (!State().dcs.contains(Key(hdc))) {
+        ++State().invalidUses;
+        return 0;
+    }
+    FreeDc(hdc);
+    return 1;
+}
+
+HBRUSH CreateSolidBrush(COLORREF) {
+    const std::uintptr_t handle = NewHandle();
+    State().objects.emplace(handle, GdiObject{GdiKind::Brush, 0});
+    return reinterpret_cast<HBRUSH>(handle);
+}
+
+HFONT CreateFontW(int height, int, int, int, int, DWORD, DWORD, DWORD, DWORD, DWORD, DWORD, DWORD, DWORD, LPCWSTR) {
+    const std::uintptr_t handle = NewHandle();
+    State().objects.emplace(handle, GdiObject{GdiKind::Font, height});
+    return reinterpret_cast<HFONT>(handle);
+}
+
+BOOL DeleteObject(HGDIOBJ object) {
+    if (IsStock(object)) return TRUE;
+    if (State().objects.erase(Key(object))) return TRUE;
+
+    ++State().invalidUses;
+    return FALSE;
+}
+
+HGDIOBJ GetStockObject(int index) {
+    return reinterpret_cast<HGDIOBJ>(kStockBase + static_cast<std::uintptr_t>(index));
+}
+
+HGDIOBJ SelectObject(HDC hdc, HGDIOBJ object) {
+    if (!CheckDc(hdc) || !CheckObject(object)) return nullptr;
+
+    HGDIOBJ &selected = State().dcs[Key(hdc)];
+    HGDIOBJ previous = selected;
+    selected = object;
+    return previous;
+}
+
+int SetBkMode(HDC hdc, int mode) {
+    return CheckDc(hdc) ? mode : 0;
+}
+
+COLORREF SetTextColor(HDC hdc, COLORREF colour) {
+    return CheckDc(hdc) ? colour : 0;
+}
+
+int FillRect(HDC hdc, const RECT *, HBRUSH brush) {
+    return CheckDc(hdc) && CheckObject(brush) ? 1 : 0;
+}
+
+int FrameRect(HDC hdc, const RECT *, HBRUSH brush) {
+    return CheckDc(hdc) && CheckObject(brush) ? 1 : 0;
+}
+
+int DrawTextW(HDC hdc, LPCWSTR text, int, RECT *rect, UINT) {
+    if (!CheckDc(hdc) || !text || !rect) return 0;
+    return rect->bottom - rect->top;
+}
+
+// Deterministic metrics, half the font height per character
+BOOL GetTextExtentPoint32W(HDC hdc, LPCWSTR, int length, SIZE *size) {
+    if (!CheckDc(hdc) || !size) return FALSE;
+
+    int height = 16;
+    const auto it = State().objects.find(Key(State().dcs[Key(hdc)]));
+    if (it != State().objects.end() && it->second.kind == GdiKind::Font) height = it->second.height;
+
+    *size = {length * height / 2, height};
+    return TRUE;
+}
@@ -0,0 +1,346 @@
+#pragma once
+// Headless stand-in for the subset of the Win32 API used by the window procs, it lets the soak harness compile
+// the application's window sources unchanged on Linux. Windows live in an in-process table, GDI objects
+// and DCs are counted so leaks show up as drifting handle counts
+#include <cstdint>
+
+#define WINAPI
+#define CALLBACK
+
+using BOOL = int;
+using BYTE = std::uint8_t;
+using WORD = std::uint16_t;
+using DWORD = std::uint32_t;
+using UINT = unsigned int;
+using LONG = std::int32_t;
+using HRESULT = std::int32_t;
+using INT_PTR = std::intptr_t;
+using UINT_PTR = std::uintptr_t;
+using LONG_PTR = std::intptr_t;
+using ULONG_PTR = std::uintptr_t;
+using DWORD_PTR = std::uintptr_t;
+using WPARAM = std::uintptr_t;
+using LPARAM = std::intptr_t;
+using LRESULT = std::intptr_t;
+using ULONGLONG = std::uint64_t;
+using COLORREF = DWORD;
+using WCHAR = wchar_t;
+using LPCWSTR = const wchar_t *;
+using LPWSTR = wchar_t *;
+using LPCSTR = const char *;
+using LPSTR = char *;
+using LPVOID = void *;
+using LPCVOID = const void *;
+
+using HANDLE = void *;
+using HGDIOBJ = void *;
+
+struct HWND__;
+struct HDC__;
+struct HBRUSH__;
+struct HFONT__;
+struct HMENU__;
+struct HINSTANCE__;
+struct HICON__;
+struct HCURSOR__;
+struct HRGN__;
+
+using HWND = HWND__ *;
+using HDC = HDC__ *;
+using HBRUSH = HBRUSH__ *;
+using HFONT = HFONT__ *;
+using HMENU = HMENU__ *;
+using HINSTANCE = HINSTANCE__ *;
+using HMODULE = HINSTANCE;
+using HICON = HICON__ *;
+using HCURSOR = HCURSOR__ *;
+using HRGN = HRGN__ *;
+
+#define TRUE 1
+#define FALSE 0
+
+#define LOWORD(l) (static_cast<WORD>(static_cast<DWORD_PTR>(l) & 0xffff))
+#define HIWORD(l) (static_cast<WORD>((static_cast<DWORD_PTR>(l) >> 16) & 0xffff))
+#define MAKEWPARAM(l, h) (static_cast<WPARAM>((static_cast<DWORD>(static_cast<WORD>(l))) | (static_cast<DWORD>(static_cast<WORD>(h)) << 16)))
+#define MAKELPARAM(l, h) (static_cast<LPARAM>((static_cast<DWORD>(static_cast<WORD>(l))) | (static_cast<DWORD>(static_cast<WORD>(h)) << 16)))
+
+#define RGB(r, g, b) (static_cast<COLORREF>((static_cast<BYTE>(r)) | (static_cast<WORD>(static_cast<BYTE>(g)) << 8) | (static_cast<DWORD>(static_cast<BYTE>(b)) << 16)))
+#define GET_WHEEL_DELTA_WPARAM(w) (static_cast<short>(HIWORD(w)))
+#define MAKEINTRESOURCEW(i) (reinterpret_cast<LPWSTR>(static_cast<ULONG_PTR>(static_cast<WORD>(i))))
+#define FAILED(hr) (static_cast<HRESULT>(hr) < 0)
+#define SUCCEEDED(hr) (static_cast<HRESULT>(hr) >= 0)
+#define S_OK 0
+
+struct RECT {
+    LONG left;
+    LONG top;
+    LONG right;
+    LONG bottom;
+};
+
+struct SIZE {
+    LONG cx;
+    LONG cy;
+};
+
+struct POINT {
+    LONG x;
+    LONG y;
+};
+
+using WNDPROC = LRESULT (CALLBACK *)(HWND, UINT, WPARAM, LPARAM);
+using TIMERPROC = void (CALLBACK *)(HWND, UINT, UINT_PTR, DWORD);
+
+struct WNDCLASSW {
+    UINT style;
+    WNDPROC lpfnWndProc;
+    int cbClsExtra;
+    int cbWndExtra;
+    HINSTANCE hInstance;
+    HICON hIcon;
+    HCURSOR hCursor;
+    HBRUSH hbrBackground;
+    LPCWSTR lpszMenuName;
+    LPCWSTR lpszClassName;
+};
+
+struct CREATESTRUCTW {
+    LPVOID lpCreateParams;
+    HINSTANCE hInstance;
+    HMENU hMenu;
+    HWND hwndParent;
+    int cy;
+    int cx;
+    int y;
+    int x;
+    LONG style;
+    LPCWSTR lpszName;
+    LPCWSTR lpszClass;
+    DWORD dwExStyle;
+};
+
+struct PAINTSTRUCT {
+    HDC hdc;
+    BOOL fErase;
+    RECT rcPaint;
+    BOOL fRestore;
+    BOOL fIncUpdate;
+    BYTE rgbReserved[32];
+};
+
+struct DRAWITEMSTRUCT {
+    UINT CtlType;
+    UINT CtlID;
+    UINT itemID;
+    UINT itemAction;
+    UINT itemState;
+    HWND hwndItem;
+    HDC hDC;
+    RECT rcItem;
+    ULONG_PTR itemData;
+};
+using LPDRAWITEMSTRUCT = DRAWITEMSTRUCT *;
+
+struct SCROLLINFO {
+    UINT cbSize;
+    UINT fMask;
+    int nMin;
+    int nMax;
+    UINT nPage;
+    int nPos;
+    int nTrackPos;
+};
+
+struct MSG {
+    HWND hwnd;
+    UINT message;
+    WPARAM wParam;
+    LPARAM lParam;
+    DWORD time;
+    POINT pt;
+};
+
+// Window messages
+#define WM_CREATE 0x0001
+#define WM_DESTROY 0x0002
+#define WM_SIZE 0x0005
+#define WM_PAINT 0x000F
+#define WM_CLOSE 0x0010
+#define WM_QUIT 0x0012
+#define WM_ERASEBKGND 0x0014
+#define WM_SETFONT 0x0030
+#define WM_GETFONT 0x0031
+#define WM_DRAWITEM 0x002B
+#define WM_NCCREATE 0x0081
+#define WM_NCDESTROY 0x0082
+#define WM_KEYDOWN 0x0100
+#define WM_COMMAND 0x0111
+#define WM_TIMER 0x0113
+#define WM_VSCROLL 0x0115
+#define WM_LBUTTONDOWN 0x0201
+#define WM_MOUSEWHEEL 0x020A
+#define WM_ENTERMENULOOP 0x0211
+#define WM_EXITMENULOOP 0x0212
+#define WM_CTLCOLORSTATIC 0x0138
+#define WM_ENTERSIZEMOVE 0x0231
+#define WM_EXITSIZEMOVE 0x0232
+
+// Window styles
+#define WS_OVERLAPPED 0x00000000L
+#define WS_TABSTOP 0x00010000L
+#define WS_MAXIMIZEBOX 0x00010000L
+#define WS_MINIMIZEBOX 0x00020000L
+#define WS_THICKFRAME 0x00040000L
+#define WS_SYSMENU 0x00080000L
+#define WS_VSCROLL 0x00200000L
+#define WS_CAPTION 0x00C00000L
+#define WS_CLIPCHILDREN 0x02000000L
+#define WS_VISIBLE 0x10000000L
+#define WS_CHILD 0x40000000L
+#define WS_OVERLAPPEDWINDOW (WS_OVERLAPPED | WS_CAPTION | WS_SYSMENU | WS_THICKFRAME | WS_MINIMIZEBOX | WS_MAXIMIZEBOX)
+#define CW_USEDEFAULT (static_cast<int>(0x80000000))
+
+#define BS_PUSHBUTTON 0x00000000L
+#define BS_OWNERDRAW 0x0000000BL
+#define BN_CLICKED 0
+
+#define WHEEL_DELTA 120
+
+#define VK_PRIOR 0x21
+#define VK_NEXT 0x22
+#define VK_END 0x23
+#define VK_HOME 0x24
+#define VK_UP 0x26
+#define VK_DOWN 0x28
+
+#define SB_VERT 1
+#define SB_LINEUP 0
+#define SB_LINEDOWN 1
+#define SB_PAGEUP 2
+#define SB_PAGEDOWN 3
+#define SB_THUMBPOSITION 4
+#define SB_THUMBTRACK 5
+#define SB_TOP 6
+#define SB_BOTTOM 7
+
+#define SIF_RANGE 0x0001
+#define SIF_PAGE 0x0002
+#define SIF_POS 0x0004
+#define SIF_DISABLENOSCROLL 0x0008
+#define SIF_TRACKPOS 0x0010
+
+#define SW_INVALIDATE 0x0002
+
+#define IDC_ARROW MAKEINTRESOURCEW(32512)
+
+#define GWLP_USERDATA (-21)
+#define SWP_NOZORDER 0x0004
+
+#define SW_HIDE 0
+#define SW_SHOW 5
+#define SW_MINIMIZE 6
+#define SW_RESTORE 9
+#define SW_MAXIMIZE 3
+
+#define SM_CXSCREEN 0
+#define SM_CYSCREEN 1
+
+#define RDW_INVALIDATE 0x0001
+#define RDW_ERASE 0x0004
+#define RDW_ALLCHILDREN 0x0080
+
+#define MB_YESNO 0x00000004L
+#define MB_ICONQUESTION 0x00000020L
+#define IDYES 6
+#define IDNO 7
+
+// GDI
+#define TRANSPARENT 1
+#define OPAQUE 2
+#define NULL_BRUSH 5
+#define DEFAULT_GUI_FONT 17
+#define FW_NORMAL 400
+#define FW_BLACK 900
+#define DEFAULT_CHARSET 1
+#define OUT_DEFAULT_PRECIS 0
+#define CLIP_DEFAULT_PRECIS 0
+#define DEFAULT_QUALITY 0
+#define DEFAULT_PITCH 0
+#define FF_DONTCARE 0
+
+#define DT_LEFT 0x00000000
+#define DT_CENTER 0x00000001
+#define DT_VCENTER 0x00000004
+#define DT_SINGLELINE 0x00000020
+#define DT_NOPREFIX 0x00000800
+#define DT_END_ELLIPSIS 0x00008000
+
+#define IMAGE_ICON 1
+#define LR_DEFAULTSIZE 0x00000040
+#define LR_SHARED 0x00008000
+
+#define PM_REMOVE 0x0001
+
+#define USER_TIMER_MINIMUM 0x0000000A
+
+// Windows
+LRESULT DefWindowProcW(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+LRESULT SendMessageW(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+unsigned short RegisterClassW(const WNDCLASSW *wndClass);
+BOOL UnregisterClassW(LPCWSTR className, HINSTANCE hInstance);
+HWND CreateWindowExW(DWORD exStyle, LPCWSTR className, LPCWSTR windowName, DWORD style,
+                     int x, int y, int width, int height,
+                     HWND parent, HMENU menu, HINSTANCE hInstance, LPVOID param);
+#define CreateWindowW(className, windowName, style, x, y, width, height, parent, menu, hInstance, param) \
+    CreateWindowExW(0, className, windowName, style, x, y, width, height, parent, menu, hInstance, param)
+BOOL DestroyWindow(HWND hwnd);
+BOOL IsWindow(HWND hwnd);
+BOOL IsIconic(HWND hwnd);
+BOOL ShowWindow(HWND hwnd, int cmdShow);
+BOOL UpdateWindow(HWND hwnd);
+BOOL SetWindowPos(HWND hwnd, HWND insertAfter, int x, int y, int cx, int cy, UINT flags);
+BOOL GetClientRect(HWND hwnd, RECT *rect);
+BOOL SetWindowTextW(HWND hwnd, LPCWSTR text);
+HWND GetDlgItem(HWND parent, int id);
+LONG_PTR SetWindowLongPtrW(HWND hwnd, int index, LONG_PTR value);
+LONG_PTR GetWindowLongPtrW(HWND hwnd, int index);
+HWND GetForegroundWindow();
+BOOL SetForegroundWindow(HWND hwnd);
+BOOL InvalidateRect(HWND hwnd, const RECT *rect, BOOL erase);
+BOOL RedrawWindow(HWND hwnd, const RECT *rect, void *region, UINT flags);
+int GetSystemMetrics(int index);
+int MessageBoxW(HWND hwnd, LPCWSTR text, LPCWSTR caption, UINT type);
+void PostQuitMessage(int exitCode);
+HMODULE GetModuleHandleW(LPCWSTR moduleName);
+HANDLE LoadImageW(HINSTANCE hInstance, LPCWSTR name, UINT type, int cx, int cy, UINT load);
+HCURSOR LoadCursorW(HINSTANCE hInstance, LPCWSTR name);
+HWND SetFocus(HWND hwnd);
+int SetScrollInfo(HWND hwnd, int bar, const SCROLLINFO *info, BOOL redraw);
+BOOL GetScrollInfo(HWND hwnd, int bar, SCROLLINFO *info);
+int ScrollWindowEx(HWND hwnd, int dx, int dy, const RECT *scroll, const RECT *clip,
+                   HRGN update, RECT *updateRect, UINT flags);
+void OutputDebugStringW(LPCWSTR text);
+void OutputDebugStringA(LPCSTR text);
+UINT_PTR SetTimer(HWND hwnd, UINT_PTR id, UINT elapseMs, TIMERPROC timerProc);
+BOOL KillTimer(HWND hwnd, UINT_PTR id);
+ULONGLONG GetTickCount64();
+
+// GDI
+HDC BeginPaint(HWND hwnd, PAINTSTRUCT *paint);
+BOOL EndPaint(HWND hwnd, const PAINTSTRUCT *paint);
+HDC GetDC(HWND hwnd);
+int ReleaseDC(HWND hwnd, HDC hdc);
+HBRUSH CreateSolidBrush(COLORREF colour);
+HFONT CreateFontW(int height, int width, int escapement, int orientation, int weight,
+                  DWORD italic, DWORD underline, DWORD strikeOut, DWORD charSet,
+                  DWORD outPrecision, DWORD clipPrecision, DWORD quality, DWORD pitchAndFamily,
+                  LPCWSTR faceName);
+BOOL DeleteObject(HGDIOBJ object);
+HGDIOBJ GetStockObject(int index);
+HGDIOBJ SelectObject(HDC hdc, HGDIOBJ object);
+int SetBkMode(HDC hdc, int mode);
+COLORREF SetTextColor(HDC hdc, COLORREF colour);
+int FillRect(HDC hdc, const RECT *rect, HBRUSH brush);
+int FrameRect(HDC hdc, const RECT *rect, HBRUSH brush);
+int DrawTextW(HDC hdc, LPCWSTR text, int length, RECT *rect, UINT format);
+BOOL GetTextExtentPoint32W(HDC hdc, LPCWSTR text, int length, SIZE *size);
@@ -0,0 +1,4 @@
+#pragma once
+#include <Windows.h>
+
+HRESULT DwmSetWindowAttribute(HWND hwnd, DWORD attribute, LPCVOID value, DWORD size);
@@ -110,6 +110,17 @@ void ButtonManager::SetSizeAndPosition(int x, int y, int width, int height) {
     SetWindowPos(hButton, nullptr, buttonX, buttonY, buttonWidth, buttonHeight, SWP_NOZORDER);
 }
 
+// Function swaps the owner-draw colours (theme change) and repaints only this button
+void ButtonManager::SetColors(COLORREF newBgColor, COLORREF newTextColor, COLORREF newBorderColor) {
+    bgColor = newBgColor;
+    textColor = newTextColor;
+    borderColor = newBorderColor;
+
+    if (hButton) {
+        InvalidateRect(hButton, nullptr, FALSE);
+    }
+}
+
 // Function computes updated dimensions, responsive to window dimensions
 void ButtonManager::ComputeResize(int updWinWidth, int updWinHeight) {
     const int newWidth = updWinWidth / widthDivisor;
@@ -0,0 +1,30 @@
+#include "app/ColourRows.h"
+
+#include <cstdint>
+
+namespace {
+    constexpr std::size_t kColourCount = std::size_t{1} << 24;
+    constexpr wchar_t kHexDigits[] = L"0123456789ABCDEF";
+}
+
+std::size_t ColourRows::RowCount() const { return kColourCount; }
+std::size_t ColourRows::ColumnCount() const { return kColumns; }
+
+/**
+ * Fills the hex code and the red, green and blue channels of the colour numbered 'row',
+ * the recycled cells keep their capacity so scrolling doesn't allocate
+ * @param row Colour as 0xRRGGBB
+ * @param cells Recycled storage sized to kColumns
+ */
+void ColourRows::FetchRow(std::size_t row, std::vector<std::wstring> &cells) {
+    const auto colour = static_cast<std::uint32_t>(row);
+
+    cells[0].assign(L"#");
+    for (int shift = 20; shift >= 0; shift -= 4) {
+        cells[0] += kHexDigits[(colour >> shift) & 0xF];
+    }
+
+    cells[1] = std::to_wstring((colour >> 16) & 0xFF);
+    cells[2] = std::to_wstring((colour >> 8) & 0xFF);
+    cells[3] = std::to_wstring(colour & 0xFF);
+}
@@ -0,0 +1,187 @@
+#include "app/MainWindow.h"
+
+#include "Resource.h"
+#include "app/AppState.h"
+#include "app/ButtonManager.h"
+#include "app/StateStore.h"
+#include "app/Theme.h"
+#include "app/TimerWheel.h"
+#include "app/VirtualListView.h"
+#include "app/WindowProcHandler.h"
+
+namespace {
+    constexpr wchar_t kClassName[] = L"MyWindowClass";
+    constexpr wchar_t kWindowTitle[] = L"Basic C++ Win32 Application";
+
+    constexpr int kInitialWidth = 1280;
+    constexpr int kInitialHeight = 720;
+
+    constexpr INT_PTR kBtnClickId = 1;
+    constexpr INT_PTR kBtnRandomId = 2;
+    constexpr INT_PTR kColourListId = 3;
+
+    constexpr int kListRowHeight = 28;
+    constexpr int kListFontSize = 20;
+    constexpr int kListHexColumnWidth = 160;
+    constexpr int kListChannelColumnWidth = 100;
+
+    constexpr StyleBinding kWindowBinding{ThemeRole::WindowBg, ThemeRole::WindowBg, ThemeRole::WindowBg};
+    constexpr StyleBinding kButtonBinding{ThemeRole::ButtonBg, ThemeRole::ButtonText, ThemeRole::ButtonBorder};
+    constexpr StyleBinding kListBinding{ThemeRole::ListBg, ThemeRole::ListText, ThemeRole::ListGrid};
+}
+
+/**
+ * Registers the parent window class as per Win32 documentation, called once before any MainWindow is created
+ * @param hInstance Handle instance
+ * @return False when the class couldn't be registered
+ */
+bool MainWindow::RegisterWindowClass(HINSTANCE hInstance) {
+    WNDCLASSW wc{};
+    wc.lpfnWndProc = WindowProcHandler::WindowProc;
+    wc.hInstance = hInstance;
+    wc.lpszClassName = kClassName;
+    wc.hIcon = static_cast<HICON>(LoadImageW(
+        hInstance,
+        MAKEINTRESOURCEW(IDI_ICON1),
+        IMAGE_ICON,
+        0, 0,
+        LR_DEFAULTSIZE | LR_SHARED
+    ));
+
+    return RegisterClassW(&wc) != 0;
+}
+
+void MainWindow::UnregisterWindowClass(HINSTANCE hInstance) {
+    UnregisterClassW(kClassName, hInstance);
+}
+
+/**
+ * MainWindow is implemented as a RAII wrapper around the parent window, it creates the AppState,
+ * the window, its buttons and colour list coloured from the active theme, then shows it with a first batch flushed
+ * @param hInstance Handle instance
+ * @param timers Timer wheel driven by the caller's message loop
+ * @param theme Theme engine the window and buttons register with
+ * @param changes Change bus flushed by the caller's message loop
+ */
+MainWindow::MainWindow(HINSTANCE hInstance, TimerWheel &timers, ThemeEngine &theme, ChangeBus &changes)
+    : theme(theme) {
+
+    // 1) Creating app state and passing its pointer to the window via lpCreateParams
+    auto state = std::make_unique<AppState>(changes);
+    AppState *stateRaw = state.get();
+    stateRaw->timers = &timers;
+    stateRaw->theme = &theme;
+    stateRaw->bgColor.Set(theme.RoleColour(ThemeRole::WindowBg));
+
+    // 2) Creates the parent window and stores the handle
+    hwnd = CreateWindowExW(
+        0,
+        kClassName,
+        L"",
+        WS_OVERLAPPEDWINDOW,
+        CW_USEDEFAULT, CW_USEDEFAULT,
+        kInitialWidth, kInitialHeight,
+        nullptr, nullptr,
+        hInstance,
+        stateRaw
+    );
+
+    // If window creation fails, the caller checks GetHwnd
+    if (!hwnd) {
+        return;
+    }
+
+    // The window now owns 'stateRaw' and will delete it in WM_NCDESTROY.
+    [[maybe_unused]] AppState *ownedByWindow = state.release();
+
+    // 3) Creating the buttons, coloured from the active theme
+    button1 = std::make_unique<ButtonManager>(
+        hwnd, hInstance,
+        0, 0,
+        5, 7,
+        L"Click Here",
+        theme.RoleColour(ThemeRole::ButtonBg),
+        theme.RoleColour(ThemeRole::ButtonText),
+        theme.RoleColour(ThemeRole::ButtonBorder),
+        32, L"Helvetica",
+        reinterpret_cast<HMENU>(kBtnClickId)
+    );
+
+    button2 = std::make_unique<ButtonManager>(
+        hwnd, hInstance,
+        0, 0,
+        5, 7,
+        L"Random Color",
+        theme.RoleColour(ThemeRole::ButtonBg),
+        theme.RoleColour(ThemeRole::ButtonText),
+        theme.RoleColour(ThemeRole::ButtonBorder),
+        32, L"Helvetica",
+        reinterpret_cast<HMENU>(kBtnRandomId)
+    );
+
+    // Colour list, sized by the first layout like the buttons, the blue column takes the remaining width
+    colourList = std::make_unique<VirtualListView>(
+        hwnd, hInstance,
+        0, 0,
+        0, 0,
+        &colourRows,
+        kListRowHeight,
+        theme.RoleColour(ThemeRole::ListBg),
+        theme.RoleColour(ThemeRole::ListText),
+        theme.RoleColour(ThemeRole::ListGrid),
+        kListFontSize, L"Helvetica",
+        reinterpret_cast<HMENU>(kColourListId)
+    );
+    colourList->SetColumns({kListHexColumnWidth, kListChannelColumnWidth, kListChannelColumnWidth});
+
+    // Stores button and list pointers into the app state
+    stateRaw->btn1 = button1.get();
+    stateRaw->btn2 = button2.get();
+    stateRaw->list = colourList.get();
+
+    // 4) Registering the parent window, buttons and list, a theme change only repaints those whose colours differ
+    HWND window = hwnd;
+    windowThemeId = theme.Register(kWindowBinding, [window](const Style &style) {
+        auto *windowState = reinterpret_cast<AppState *>(GetWindowLongPtrW(window, GWLP_USERDATA));
+        if (windowState) windowState->bgColor.Set(style.bg);
+        WindowProcHandler::ApplyTitleBarTheme(window, style.bg);
+    });
+
+    ButtonManager *first = button1.get();
+    ButtonManager *second = button2.get();
+    button1ThemeId = theme.Register(kButtonBinding, [first](const Style &style) {
+        first->SetColors(style.bg, style.text, style.border);
+    });
+    button2ThemeId = theme.Register(kButtonBinding, [second](const Style &style) {
+        second->SetColors(style.bg, style.text, style.border);
+    });
+
+    VirtualListView *list = colourList.get();
+    listThemeId = theme.Register(kListBinding, [list](const Style &style) {
+        list->SetColors(style.bg, style.text, style.border);
+    });
+
+    // Title bar follows the theme, dark for dark backgrounds and light otherwise
+    WindowProcHandler::ApplyTitleBarTheme(hwnd, theme.RoleColour(ThemeRole::WindowBg));
+
+    // 5) Shows the window with the first batch of state changes already applied
+    ShowWindow(hwnd, SW_MAXIMIZE);
+    SetWindowTextW(hwnd, kWindowTitle);
+    changes.Flush();
+    UpdateWindow(hwnd);
+}
+
+// Object destructor destroys the window while the controls it lays out still exist, then drops the registrations
+MainWindow::~MainWindow() {
+    if (hwnd && IsWindow(hwnd)) {
+        DestroyWindow(hwnd);
+    }
+    hwnd = nullptr;
+
+    theme.Unregister(windowThemeId);
+    theme.Unregister(button1ThemeId);
+    theme.Unregister(button2ThemeId);
+    theme.Unregister(listThemeId);
+}
+
+HWND MainWindow::GetHwnd() const { return hwnd; }
@@ -0,0 +1,81 @@
+#include "app/StateStore.h"
+
+/**
+ * Registers a subscriber, it is called at most once per flush and only when the batch
+ * contains one of the keys it is interested in
+ * @param interest Keys the subscriber reacts to
+ * @param subscriber Receives the subset of the batch matching 'interest'
+ * @return Subscription identifier for Unsubscribe
+ */
+ChangeBus::SubscriptionId ChangeBus::Subscribe(ChangeMask interest, Subscriber subscriber) {
+    SubscriptionId id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+    } else {
+        id = static_cast<SubscriptionId>(entries.size() + added.size());
+    }
+
+    if (flushing) {
+        added.emplace_back(id, Entry{interest, std::move(subscriber)});
+        return id;
+    }
+
+    if (id >= entries.size()) entries.resize(id + 1);
+    entries[id] = Entry{interest, std::move(subscriber)};
+    return id;
+}
+
+// Disables a subscription, safe to call from inside a subscriber
+void ChangeBus::Unsubscribe(SubscriptionId id) {
+    for (auto &[addedId, entry] : added) {
+        if (addedId == id && entry.interest) {
+            entry.interest = 0;
+            freeIds.push_back(id);
+            return;
+        }
+    }
+
+    if (id >= entries.size() || !entries[id].interest) return;
+
+    // The callable is only dropped outside a flush, it may be the one running right now
+    entries[id].interest = 0;
+    if (!flushing) entries[id].subscriber = nullptr;
+    freeIds.push_back(id);
+}
+
+/**
+ * Delivers everything written since the previous flush as one batch
+ * @return Number of subscribers called
+ */
+std::size_t ChangeBus::Flush() {
+    if (!pending || flushing) return 0;
+
+    flushing = true;
+    const ChangeMask batch = pending;
+    pending = 0;
+
+    std::size_t delivered = 0;
+    for (const Entry &entry : entries) {
+        const ChangeMask relevant = entry.interest & batch;
+        if (!relevant) continue;
+
+        entry.subscriber(relevant);
+        ++delivered;
+    }
+
+    flushing = false;
+
+    // Merging late subscriptions and releasing the callables of ones dropped during the flush
+    for (auto &[id, entry] : added) {
+        if (id >= entries.size()) entries.resize(id + 1);
+        entries[id] = std::move(entry);
+    }
+    added.clear();
+
+    for (Entry &entry : entries) {
+        if (!entry.interest) entry.subscriber = nullptr;
+    }
+
+    return delivered;
+}
@@ -0,0 +1,173 @@
+#include "app/Theme.h"
+
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+#include <utility>
+
+namespace {
+    std::string_view Trim(std::string_view text) {
+        constexpr std::string_view kSpace = " \t\r\n";
+        const auto first = text.find_first_not_of(kSpace);
+        if (first == std::string_view::npos) return {};
+        const auto last = text.find_last_not_of(kSpace);
+        return text.substr(first, last - first + 1);
+    }
+
+    bool ParseChannel(std::string_view text, int base, std::uint8_t &out) {
+        text = Trim(text);
+        unsigned value = 0;
+        const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value, base);
+        if (ec != std::errc{} || end != text.data() + text.size() || value > 255) return false;
+        out = static_cast<std::uint8_t>(value);
+        return true;
+    }
+
+    // Accepts "#RRGGBB" or "r, g, b"
+    std::optional<Colour> ParseColour(std::string_view text) {
+        std::uint8_t r = 0, g = 0, b = 0;
+
+        if (text.size() == 7 && text[0] == '#') {
+            if (ParseChannel(text.substr(1, 2), 16, r) &&
+                ParseChannel(text.substr(3, 2), 16, g) &&
+                ParseChannel(text.substr(5, 2), 16, b)) {
+                return MakeColour(r, g, b);
+            }
+            return std::nullopt;
+        }
+
+        const auto firstComma = text.find(',');
+        const auto secondComma = text.find(',', firstComma + 1);
+        if (firstComma == std::string_view::npos || secondComma == std::string_view::npos) return std::nullopt;
+
+        if (ParseChannel(text.substr(0, firstComma), 10, r) &&
+            ParseChannel(text.substr(firstComma + 1, secondComma - firstComma - 1), 10, g) &&
+            ParseChannel(text.substr(secondComma + 1), 10, b)) {
+            return MakeColour(r, g, b);
+        }
+        return std::nullopt;
+    }
+
+    std::optional<ThemeRole> RoleFromName(std::string_view name) {
+        for (std::size_t i = 0; i < kThemeRoleNames.size(); ++i) {
+            if (kThemeRoleNames[i] == name) return static_cast<ThemeRole>(i);
+        }
+        return std::nullopt;
+    }
+
+    void SetError(std::string *error, std::size_t line, std::string_view message) {
+        if (!error) return;
+        *error = "line " + std::to_string(line) + ": " + std::string(message);
+    }
+}
+
+/**
+ * Looks up one of the constexpr built-in themes by name
+ * @param name Theme name, e.g. "dark"
+ * @return Colour table or nothing for an unknown name
+ */
+std::optional<ThemeTable> FindBuiltInTheme(std::string_view name) {
+    for (const auto &theme : kBuiltInThemes) {
+        if (theme.name == name) return theme.table;
+    }
+    return std::nullopt;
+}
+
+/**
+ * Parses a user theme, one "key = value" per line with '#' starting a comment line. An optional
+ * "base = <built-in name>" anywhere in the file picks the table that roles not listed in it fall back to
+ * @param text Whole theme file contents
+ * @param error Receives a line-numbered message when parsing fails
+ * @return Colour table or nothing when the text is malformed
+ */
+std::optional<ThemeTable> ParseTheme(std::string_view text, std::string *error) {
+    ThemeTable table = kDefaultTheme;
+    std::array<std::optional<Colour>, kThemeRoleCount> overrides{};
+    std::size_t lineNumber = 0;
+
+    while (!text.empty()) {
+        const auto newline = text.find('\n');
+        const std::string_view line = Trim(text.substr(0, newline));
+        text = newline == std::string_view::npos ? std::string_view{} : text.substr(newline + 1);
+        ++lineNumber;
+
+        if (line.empty() || line.front() == '#') continue;
+
+        const auto equals = line.find('=');
+        if (equals == std::string_view::npos) {
+            SetError(error, lineNumber, "expected 'key = value'");
+            return std::nullopt;
+        }
+
+        const std::string_view key = Trim(line.substr(0, equals));
+        const std::string_view value = Trim(line.substr(equals + 1));
+
+        // Role lines are applied over the base once the whole file is read, so their order doesn't matter
+        if (key == "base") {
+            const auto base = FindBuiltInTheme(value);
+            if (!base) {
+                SetError(error, lineNumber, "unknown base theme '" + std::string(value) + "'");
+                return std::nullopt;
+            }
+            table = *base;
+            continue;
+        }
+
+        const auto role = RoleFromName(key);
+        if (!role) {
+            SetError(error, lineNumber, "unknown key '" + std::string(key) + "'");
+            return std::nullopt;
+        }
+
+        const auto colour = ParseColour(value);
+        if (!colour) {
+            SetError(error, lineNumber, "bad colour '" + std::string(value) + "'");
+            return std::nullopt;
+        }
+
+        overrides[static_cast<std::size_t>(*role)] = *colour;
+    }
+
+    for (std::size_t i = 0; i < kThemeRoleCount; ++i) {
+        if (overrides[i]) table[static_cast<ThemeRole>(i)] = *overrides[i];
+    }
+
+    return table;
+}
+
+ThemeFileWatcher::ThemeFileWatcher(std::filesystem::path path) : path(std::move(path)) {}
+
+/**
+ * Reloads the theme file when its write time differs from the last poll, deleting a loaded file reverts
+ * to the default theme and a malformed one is only reported on the poll that read it
+ * @param error Receives the reason when the changed file couldn't be loaded
+ * @return Freshly parsed table, the default table right after the file disappeared,
+ * or nothing when the file is unchanged, still missing or malformed
+ */
+std::optional<ThemeTable> ThemeFileWatcher::Poll(std::string *error) {
+    std::error_code ec;
+    const auto writeTime = std::filesystem::last_write_time(path, ec);
+
+    // Forgetting the write time also makes a restored file load even if it kept its old timestamp
+    if (ec) {
+        if (!lastWrite) return std::nullopt;
+        lastWrite.reset();
+        return kDefaultTheme;
+    }
+
+    if (lastWrite && *lastWrite == writeTime) return std::nullopt;
+
+    lastWrite = writeTime;
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        if (error) *error = "cannot open " + path.string();
+        return std::nullopt;
+    }
+
+    std::ostringstream contents;
+    contents << file.rdbuf();
+
+    return ParseTheme(contents.str(), error);
+}
@@ -0,0 +1,153 @@
+#include "app/ThemeEngine.h"
+
+#include <utility>
+
+/**
+ * Creates the engine with no controls registered
+ * @param initial Theme table the controls are first resolved against
+ */
+ThemeEngine::ThemeEngine(const ThemeTable &initial) : table(initial) {}
+
+/**
+ * Registers a control, its style is resolved straight away and handed back through StyleOf,
+ * the callback only runs later when an applied theme changes one of the bound roles
+ * @param binding Theme roles feeding the control's style fields
+ * @param onRestyle Invoked with the new style, usually updates cached colours and invalidates the HWND
+ * @return Control identifier, valid until Unregister
+ */
+ThemeEngine::ControlId ThemeEngine::Register(StyleBinding binding, RestyleCallback onRestyle) {
+    ControlId id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+    } else {
+        id = static_cast<ControlId>(controls.size());
+        controls.emplace_back();
+    }
+
+    Control &control = controls[id];
+    control.binding = binding;
+    control.style = Resolve(binding);
+    control.onRestyle = std::move(onRestyle);
+    control.visitedApply = applyCount;
+    control.live = true;
+
+    // A control appears once per distinct role so a change is never reported twice
+    const auto roles = Roles(binding);
+    for (std::size_t i = 0; i < roles.size(); ++i) {
+        bool duplicate = false;
+        for (std::size_t j = 0; j < i; ++j) duplicate |= roles[j] == roles[i];
+
+        if (duplicate) {
+            control.rolePos[i] = kNotListed;
+            continue;
+        }
+
+        auto &list = roleControls[static_cast<std::size_t>(roles[i])];
+        control.rolePos[i] = static_cast<std::uint32_t>(list.size());
+        list.push_back(id);
+    }
+
+    ++liveCount;
+    return id;
+}
+
+// Removes a control from every role list in O(1) by swapping the last entry into its place
+void ThemeEngine::Unregister(ControlId id) {
+    if (id >= controls.size() || !controls[id].live) return;
+
+    Control &control = controls[id];
+    const auto roles = Roles(control.binding);
+
+    for (std::size_t i = 0; i < roles.size(); ++i) {
+        const std::uint32_t pos = control.rolePos[i];
+        if (pos == kNotListed) continue;
+
+        auto &list = roleControls[static_cast<std::size_t>(roles[i])];
+        const ControlId moved = list.back();
+        list[pos] = moved;
+        list.pop_back();
+
+        // The moved control keeps a position for this role under whichever field bound it first
+        if (moved != id) {
+            Control &other = controls[moved];
+            const auto otherRoles = Roles(other.binding);
+            for (std::size_t k = 0; k < otherRoles.size(); ++k) {
+                if (otherRoles[k] == roles[i] && other.rolePos[k] != kNotListed) {
+                    other.rolePos[k] = pos;
+                    break;
+                }
+            }
+        }
+
+        control.rolePos[i] = kNotListed;
+    }
+
+    control.onRestyle = nullptr;
+    control.live = false;
+    ++control.generation;
+    freeIds.push_back(id);
+    --liveCount;
+}
+
+/**
+ * Switches to a new theme table, only controls bound to a role whose colour changed are
+ * re-resolved and only those whose style really differs get their callback. Callbacks may
+ * register or unregister controls, but must not call Apply themselves
+ * @param next Theme table to apply
+ * @return Number of controls restyled, 0 when called from a restyle callback
+ */
+std::size_t ThemeEngine::Apply(const ThemeTable &next) {
+    if (applying) return 0;
+
+    const ThemeTable previous = table;
+    table = next;
+    ++applyCount;
+
+    restyled.clear();
+
+    for (std::size_t role = 0; role < kThemeRoleCount; ++role) {
+        if (previous.colours[role] == next.colours[role]) continue;
+
+        for (const ControlId id : roleControls[role]) {
+            Control &control = controls[id];
+            if (control.visitedApply == applyCount) continue;
+            control.visitedApply = applyCount;
+
+            const Style style = Resolve(control.binding);
+            if (style == control.style) continue;
+
+            control.style = style;
+            restyled.push_back({id, control.generation});
+        }
+    }
+
+    // Callbacks run after the diff so they may register or unregister controls themselves,
+    // a control unregistered meanwhile is skipped even when a new one already reuses its id
+    applying = true;
+    const std::size_t count = restyled.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        const Control &control = controls[restyled[i].id];
+        if (control.live && control.generation == restyled[i].generation && control.onRestyle) {
+            const Style style = control.style;
+            RestyleCallback callback = control.onRestyle;
+            callback(style);
+        }
+    }
+    applying = false;
+
+    return count;
+}
+
+Colour ThemeEngine::RoleColour(ThemeRole role) const { return table[role]; }
+const Style &ThemeEngine::StyleOf(ControlId id) const { return controls[id].style; }
+const ThemeTable &ThemeEngine::Current() const { return table; }
+std::size_t ThemeEngine::ControlCount() const { return liveCount; }
+
+Style ThemeEngine::Resolve(const StyleBinding &binding) const {
+    return {table[binding.bg], table[binding.text], table[binding.border]};
+}
+
+std::array<ThemeRole, 3> ThemeEngine::Roles(const StyleBinding &binding) {
+    return {binding.bg, binding.text, binding.border};
+}
@@ -0,0 +1,223 @@
+#include "app/TimerWheel.h"
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+namespace {
+    constexpr std::uint64_t kSlotMask = TimerWheel::kSlots - 1;
+    constexpr std::uint64_t kWheelSpan = std::uint64_t{1} << (TimerWheel::kLevels * TimerWheel::kSlotBits);
+
+    // Picks the level from the highest bit where deadline and current time differ
+    int LevelFor(std::uint64_t elapsed, std::uint64_t deadline) {
+        const std::uint64_t masked = (elapsed ^ deadline) | kSlotMask;
+        if (masked >= kWheelSpan) {
+            return TimerWheel::kLevels - 1;
+        }
+        const int significant = 63 - std::countl_zero(masked);
+        return significant / TimerWheel::kSlotBits;
+    }
+
+    int SlotFor(std::uint64_t deadline, int level) {
+        return static_cast<int>((deadline >> (level * TimerWheel::kSlotBits)) & kSlotMask);
+    }
+}
+
+/**
+ * Creates an empty wheel whose current time is nowMs, every later Schedule call is relative
+ * to the time given to the latest Advance call
+ * @param nowMs Starting time in milliseconds
+ */
+TimerWheel::TimerWheel(std::uint64_t nowMs) : elapsed(nowMs) {
+    slotHeads.fill(kNil);
+}
+
+/**
+ * Arms a one-shot timer, a zero delay is rounded up to the next millisecond so it fires on the next Advance
+ * @param delayMs Delay from the wheel's current time, clamped to kMaxDelay
+ * @param callback Invoked once from Advance when the timer expires
+ * @return Handle that can be passed to Cancel
+ */
+TimerWheel::TimerId TimerWheel::Schedule(std::uint64_t delayMs, Callback callback) {
+    const std::uint32_t index = AllocateNode();
+    Node &node = nodes[index];
+
+    node.deadline = elapsed + std::clamp<std::uint64_t>(delayMs, 1, kMaxDelay);
+    node.callback = std::move(callback);
+    node.armed = true;
+
+    Insert(index);
+    ++armedCount;
+
+    return {index, node.generation};
+}
+
+/**
+ * Disarms a pending timer in O(1), timers already collected into the batch being fired can't be cancelled
+ * @param id Handle returned by Schedule
+ * @return True when a pending timer was removed
+ */
+bool TimerWheel::Cancel(TimerId id) {
+    if (id.index >= nodes.size()) return false;
+
+    Node &node = nodes[id.index];
+    if (!node.armed || node.generation != id.generation) return false;
+
+    Unlink(id.index);
+    ReleaseNode(id.index);
+    --armedCount;
+    return true;
+}
+
+/**
+ * Moves the wheel forward to nowMs, cascading timers from the upper levels as their slots come due
+ * and then firing every expired callback as one batch. Callbacks may schedule or cancel timers,
+ * but must not call Advance themselves
+ * @param nowMs Current time in milliseconds
+ * @return Number of callbacks fired
+ */
+std::size_t TimerWheel::Advance(std::uint64_t nowMs) {
+    if (nowMs < elapsed || !firing.empty()) return 0;
+
+    while (const auto expiration = NextExpiration()) {
+        if (expiration->deadline > nowMs) break;
+
+        elapsed = expiration->deadline;
+
+        const int bucket = expiration->level * kSlots + expiration->slot;
+        std::uint32_t index = slotHeads[bucket];
+        slotHeads[bucket] = kNil;
+        occupied[expiration->level] &= ~(std::uint64_t{1} << expiration->slot);
+
+        // Due entries are collected, the rest land on a lower level closer to their deadline
+        while (index != kNil) {
+            const std::uint32_t next = nodes[index].next;
+
+            if (nodes[index].deadline <= elapsed) {
+                firing.push_back(std::move(nodes[index].callback));
+                ReleaseNode(index);
+                --armedCount;
+            } else {
+                Insert(index);
+            }
+
+            index = next;
+        }
+    }
+
+    elapsed = nowMs;
+
+    // Indexed loop since callbacks may schedule new timers while the batch runs
+    const std::size_t fired = firing.size();
+    for (std::size_t i = 0; i < fired; ++i) {
+        firing[i]();
+    }
+    firing.clear();
+
+    return fired;
+}
+
+/**
+ * Earliest time the wheel needs servicing, this is either an exact deadline or the moment
+ * an upper level slot has to cascade, so it never lies after the real next expiry
+ * @return Time in milliseconds or nothing when no timer is pending
+ */
+std::optional<std::uint64_t> TimerWheel::NextDeadline() const {
+    if (const auto expiration = NextExpiration()) {
+        return expiration->deadline;
+    }
+    return std::nullopt;
+}
+
+std::uint64_t TimerWheel::Now() const { return elapsed; }
+std::size_t TimerWheel::Size() const { return armedCount; }
+
+// Scans the occupancy bitmaps, lower levels always expire before higher ones
+std::optional<TimerWheel::Expiration> TimerWheel::NextExpiration() const {
+    for (int level = 0; level < kLevels; ++level) {
+        if (!occupied[level]) continue;
+
+        const int shift = level * kSlotBits;
+        const std::uint64_t slotRange = std::uint64_t{1} << shift;
+        const std::uint64_t levelRange = slotRange << kSlotBits;
+
+        const int nowSlot = static_cast<int>((elapsed >> shift) & kSlotMask);
+        const int zeros = std::countr_zero(std::rotr(occupied[level], nowSlot));
+        const int slot = (zeros + nowSlot) & static_cast<int>(kSlotMask);
+
+        std::uint64_t deadline = (elapsed & ~(levelRange - 1)) + static_cast<std::uint64_t>(slot) * slotRange;
+
+        // Only the top level wraps, its far-future slots sit "behind" the current one
+        if (deadline < elapsed) {
+            deadline += levelRange;
+        }
+
+        return Expiration{level, slot, deadline};
+    }
+
+    return std::nullopt;
+}
+
+// Pushes the node onto the front of its slot list
+void TimerWheel::Insert(std::uint32_t index) {
+    Node &node = nodes[index];
+
+    const int level = LevelFor(elapsed, node.deadline);
+    const int slot = SlotFor(node.deadline, level);
+    const int bucket = level * kSlots + slot;
+
+    node.bucket = static_cast<std::uint16_t>(bucket);
+    node.prev = kNil;
+    node.next = slotHeads[bucket];
+
+    if (node.next != kNil) {
+        nodes[node.next].prev = index;
+    }
+
+    slotHeads[bucket] = index;
+    occupied[level] |= std::uint64_t{1} << slot;
+}
+
+// Removes the node from its slot list, clearing the occupancy bit once the slot empties
+void TimerWheel::Unlink(std::uint32_t index) {
+    const Node &node = nodes[index];
+
+    if (node.prev != kNil) {
+        nodes[node.prev].next = node.next;
+    } else {
+        slotHeads[node.bucket] = node.next;
+    }
+
+    if (node.next != kNil) {
+        nodes[node.next].prev = node.prev;
+    }
+
+    if (slotHeads[node.bucket] == kNil) {
+        occupied[node.bucket / kSlots] &= ~(std::uint64_t{1} << (node.bucket % kSlots));
+    }
+}
+
+// Takes a node from the free list, the node pool only grows to the peak number of pending timers
+std::uint32_t TimerWheel::AllocateNode() {
+    if (freeHead != kNil) {
+        const std::uint32_t index = freeHead;
+        freeHead = nodes[index].next;
+        return index;
+    }
+
+    nodes.emplace_back();
+    return static_cast<std::uint32_t>(nodes.size() - 1);
+}
+
+// Bumping the generation invalidates every TimerId still referring to this node
+void TimerWheel::ReleaseNode(std::uint32_t index) {
+    Node &node = nodes[index];
+
+    node.callback = nullptr;
+    node.armed = false;
+    ++node.generation;
+
+    node.prev = kNil;
+    node.next = freeHead;
+    freeHead = index;
+}
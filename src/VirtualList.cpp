@@ -0,0 +1,202 @@
+#include "app/VirtualList.h"
+
+#include <algorithm>
+#include <utility>
+
+/**
+ * Creates the virtual list model, nothing is fetched until a visible row is requested
+ * @param provider Non-owning pull-based data source, may be set later
+ * @param rowHeight Height of every row in pixels
+ */
+VirtualList::VirtualList(RowProvider *provider, int rowHeight)
+    : provider(provider),
+      rowHeight(std::max(rowHeight, 1)) {
+    SetColumns({});
+    ResizeCache();
+}
+
+// Swaps the data source and scrolls back to the top, every cached row is dropped
+void VirtualList::SetProvider(RowProvider *newProvider) {
+    provider = newProvider;
+    topRow = 0;
+    SetColumns(std::move(columnWidths));
+    InvalidateRows();
+}
+
+/**
+ * Sets explicit column widths, columns without a width share whatever viewport width is left
+ * @param widths Column widths in pixels, in column order
+ */
+void VirtualList::SetColumns(std::vector<int> widths) {
+    columnWidths = std::move(widths);
+
+    const std::size_t count = std::max(ColumnCount(), columnWidths.size());
+    int fixedWidth = 0;
+    for (const int w : columnWidths) fixedWidth += std::max(w, 0);
+
+    const std::size_t flexible = count - columnWidths.size();
+    const int flexibleWidth = flexible
+        ? std::max((viewportWidth - fixedWidth) / static_cast<int>(flexible), 1)
+        : 0;
+
+    columnLefts.assign(count + 1, 0);
+    for (std::size_t c = 0; c < count; ++c) {
+        const int w = c < columnWidths.size() ? std::max(columnWidths[c], 0) : flexibleWidth;
+        columnLefts[c + 1] = columnLefts[c] + w;
+    }
+}
+
+// Updates the client area size, the row cache is resized to hold every partially visible row
+void VirtualList::SetViewport(int width, int height) {
+    viewportWidth = std::max(width, 0);
+    viewportHeight = std::max(height, 0);
+
+    SetColumns(std::move(columnWidths));
+    ResizeCache();
+    topRow = std::min(topRow, MaxTopRow());
+}
+
+// Marks every cached row stale, used when the provider's data changed underneath the list
+void VirtualList::InvalidateRows() {
+    for (RowSlot &slot : cache) {
+        slot.row = kNoRow;
+    }
+    topRow = std::min(topRow, MaxTopRow());
+}
+
+/**
+ * Scrolls so 'row' becomes the top row, small moves report the pixel shift and the newly exposed
+ * rows so the caller can blit and only paint those, moves of a page or more repaint everything
+ * @param row Requested top row, clamped so the last row stays at the bottom
+ * @return What the caller has to repaint
+ */
+ScrollResult VirtualList::ScrollTo(std::size_t row) {
+    const std::size_t target = std::min(row, MaxTopRow());
+    if (target == topRow) return {};
+
+    const bool down = target > topRow;
+    const std::size_t distance = down ? target - topRow : topRow - target;
+    topRow = target;
+
+    ScrollResult result;
+    const std::size_t visibleCount = (static_cast<std::size_t>(viewportHeight) + rowHeight - 1) / rowHeight;
+
+    if (distance >= visibleCount) {
+        result.repaintAll = true;
+        result.exposed = VisibleRows();
+        return result;
+    }
+
+    const int shift = static_cast<int>(distance) * rowHeight;
+    result.pixels = down ? -shift : shift;
+    result.exposed = down ? RowsInBand(viewportHeight - shift, viewportHeight) : RowsInBand(0, shift);
+    return result;
+}
+
+// Relative scroll in rows, negative values scroll up and saturate at the first row
+ScrollResult VirtualList::ScrollBy(std::int64_t rows) {
+    if (rows < 0) {
+        const auto up = static_cast<std::size_t>(-(rows + 1)) + 1;
+        return ScrollTo(up > topRow ? 0 : topRow - up);
+    }
+    return ScrollTo(topRow + static_cast<std::size_t>(rows));
+}
+
+/**
+ * Returns the cells of a row, pulling them from the provider only when the row isn't cached yet,
+ * a slot's strings are reused by the next row landing on it so steady scrolling doesn't allocate
+ * @param row Row index, must be below RowCount()
+ * @return Cached cells, valid until the slot is recycled
+ */
+const std::vector<std::wstring> &VirtualList::RowAt(std::size_t row) {
+    RowSlot &slot = cache[row % cache.size()];
+
+    if (slot.row != row) {
+        slot.cells.resize(ColumnCount());
+        if (provider) provider->FetchRow(row, slot.cells);
+        slot.row = row;
+    }
+
+    return slot.cells;
+}
+
+// Rows that are at least partially visible
+RowRange VirtualList::VisibleRows() const {
+    return RowsInBand(0, viewportHeight);
+}
+
+/**
+ * Rows intersecting a horizontal band of the viewport, used to map an invalid rectangle to rows
+ * @param top Band top in client pixels
+ * @param bottom Band bottom in client pixels (exclusive)
+ * @return Row range, empty when the band lies outside the data
+ */
+RowRange VirtualList::RowsInBand(int top, int bottom) const {
+    top = std::max(top, 0);
+    bottom = std::min(bottom, viewportHeight);
+    if (bottom <= top) return {};
+
+    const std::size_t count = RowCount();
+    const std::size_t first = topRow + static_cast<std::size_t>(top / rowHeight);
+    const std::size_t last = topRow + static_cast<std::size_t>((bottom + rowHeight - 1) / rowHeight);
+
+    return {std::min(first, count), std::min(last, count)};
+}
+
+/**
+ * Maps a client point to a cell
+ * @param x Client x-axis pos.
+ * @param y Client y-axis pos.
+ * @return Hit cell, 'valid' is false when the point is outside every cell
+ */
+CellHit VirtualList::HitTest(int x, int y) const {
+    if (x < 0 || y < 0 || y >= viewportHeight || x >= columnLefts.back()) return {};
+
+    const std::size_t row = topRow + static_cast<std::size_t>(y / rowHeight);
+    if (row >= RowCount()) return {};
+
+    const auto it = std::upper_bound(columnLefts.begin(), columnLefts.end(), x);
+    const auto column = static_cast<std::size_t>(it - columnLefts.begin()) - 1;
+
+    return {row, column, true};
+}
+
+// Client y-axis pos. of a visible row
+int VirtualList::RowTop(std::size_t row) const {
+    return static_cast<int>(row - topRow) * rowHeight;
+}
+
+int VirtualList::ColumnLeft(std::size_t column) const {
+    return column < columnLefts.size() ? columnLefts[column] : columnLefts.back();
+}
+
+int VirtualList::ColumnWidth(std::size_t column) const {
+    return column + 1 < columnLefts.size() ? columnLefts[column + 1] - columnLefts[column] : 0;
+}
+
+std::size_t VirtualList::RowCount() const { return provider ? provider->RowCount() : 0; }
+std::size_t VirtualList::ColumnCount() const { return provider ? provider->ColumnCount() : 0; }
+std::size_t VirtualList::TopRow() const { return topRow; }
+
+std::size_t VirtualList::MaxTopRow() const {
+    const std::size_t count = RowCount();
+    const std::size_t page = PageRows();
+    return count > page ? count - page : 0;
+}
+
+// Number of fully visible rows, at least one so paging always moves
+std::size_t VirtualList::PageRows() const {
+    return std::max(viewportHeight / rowHeight, 1);
+}
+
+int VirtualList::RowHeight() const { return rowHeight; }
+int VirtualList::ViewportWidth() const { return viewportWidth; }
+int VirtualList::ViewportHeight() const { return viewportHeight; }
+
+// One slot per partially visible row plus one, so scrolling by a row keeps the others cached
+void VirtualList::ResizeCache() {
+    const std::size_t needed = static_cast<std::size_t>((viewportHeight + rowHeight - 1) / rowHeight) + 1;
+    if (cache.size() == needed) return;
+
+    cache.assign(needed, RowSlot{});
+}
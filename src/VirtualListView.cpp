@@ -0,0 +1,351 @@
+#include "app/VirtualListView.h"
+
+#include <algorithm>
+#include <climits>
+#include <utility>
+
+namespace {
+    constexpr wchar_t kListClassName[] = L"VirtualListViewClass";
+
+    constexpr int kWheelRows = 3;
+    constexpr int kCellPadding = 6;
+
+    // Largest scroll bar range used before row positions get scaled down to fit an int
+    constexpr std::size_t kMaxScrollRange = INT_MAX / 2;
+}
+
+/**
+ * VirtualListView is implemented as a RAII wrapper around one owner-drawn child window (CreateWindowEx,
+ * font and brush setup, scrolling, destruction), rows are pulled from the provider only while visible
+ * @param parentHwnd Parent window handle
+ * @param hInstance Handle instance
+ * @param x Control x-axis pos.
+ * @param y Control y-axis pos.
+ * @param width Control width
+ * @param height Control height
+ * @param provider Non-owning pull-based data source
+ * @param rowHeight Height of every row in pixels
+ * @param bgColor
+ * @param textColor
+ * @param gridColor
+ * @param fontSize
+ * @param fontFamily
+ * @param controlId Control instance identifier
+ */
+VirtualListView::VirtualListView(HWND parentHwnd,
+                                 HINSTANCE hInstance,
+                                 int x, int y,
+                                 int width, int height,
+                                 RowProvider *provider,
+                                 int rowHeight,
+                                 COLORREF bgColor,
+                                 COLORREF textColor,
+                                 COLORREF gridColor,
+                                 int fontSize,
+                                 LPCWSTR fontFamily,
+                                 HMENU controlId)
+    : model(provider, rowHeight),
+      textColor(textColor) {
+
+    static bool listRegistered = false;
+
+    if (!listRegistered) {
+        WNDCLASSW listWndClass{};
+        listWndClass.lpfnWndProc = ListWindowProc;
+        listWndClass.hInstance = hInstance;
+        listWndClass.lpszClassName = kListClassName;
+        listWndClass.hCursor = LoadCursorW(nullptr, IDC_ARROW);
+
+        RegisterClassW(&listWndClass);
+        listRegistered = true;
+    }
+
+    // Brushes and font are created once and shared by every row painted
+    bgBrush = CreateSolidBrush(bgColor);
+    gridBrush = CreateSolidBrush(gridColor);
+
+    hFont = CreateFontW(
+        fontSize, 0, 0, 0,
+        FW_NORMAL,
+        FALSE, FALSE, FALSE,
+        DEFAULT_CHARSET,
+        OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS, DEFAULT_QUALITY,
+        DEFAULT_PITCH | FF_DONTCARE,
+        fontFamily
+    );
+
+    // Creating the underlying window, 'this' is handed over through lpCreateParams
+    hList = CreateWindowExW(
+        0,
+        kListClassName,
+        L"",
+        WS_CHILD | WS_VISIBLE | WS_VSCROLL | WS_TABSTOP,
+        x, y,
+        width, height,
+        parentHwnd,
+        controlId,
+        hInstance,
+        this
+    );
+}
+
+// Object destructor destroys the window before releasing the GDI objects it paints with
+VirtualListView::~VirtualListView() {
+    if (hList && IsWindow(hList)) {
+        DestroyWindow(hList);
+    }
+    hList = nullptr;
+
+    if (hFont) {
+        DeleteObject(hFont);
+        hFont = nullptr;
+    }
+    if (bgBrush) {
+        DeleteObject(bgBrush);
+        bgBrush = nullptr;
+    }
+    if (gridBrush) {
+        DeleteObject(gridBrush);
+        gridBrush = nullptr;
+    }
+}
+
+// Function sets the size and pos. of the list, WM_SIZE updates the viewport
+void VirtualListView::SetSizeAndPosition(int x, int y, int width, int height) {
+    if (!hList) return;
+
+    SetWindowPos(hList, nullptr, x, y, width, height, SWP_NOZORDER);
+}
+
+// Function sets column widths in pixels, columns without a width share the remaining space
+void VirtualListView::SetColumns(std::vector<int> widths) {
+    model.SetColumns(std::move(widths));
+    if (hList) InvalidateRect(hList, nullptr, FALSE);
+}
+
+// Function swaps the brushes and text colour (theme change) and repaints the visible rows
+void VirtualListView::SetColors(COLORREF newBgColor, COLORREF newTextColor, COLORREF newGridColor) {
+    if (bgBrush) DeleteObject(bgBrush);
+    if (gridBrush) DeleteObject(gridBrush);
+
+    bgBrush = CreateSolidBrush(newBgColor);
+    gridBrush = CreateSolidBrush(newGridColor);
+    textColor = newTextColor;
+
+    if (hList) InvalidateRect(hList, nullptr, FALSE);
+}
+
+// Function scrolls so the given row is at the top, blitting when the move is small
+void VirtualListView::ScrollToRow(std::size_t row) {
+    ApplyScroll(model.ScrollTo(row));
+}
+
+// Function drops every cached row and repaints, used when the provider's data changed
+void VirtualListView::Refresh() {
+    model.InvalidateRows();
+    UpdateScrollBar();
+    if (hList) InvalidateRect(hList, nullptr, FALSE);
+}
+
+HWND VirtualListView::GetHwnd() const { return hList; }
+std::size_t VirtualListView::GetTopRow() const { return model.TopRow(); }
+
+/**
+ * List window proc. function, it uses the owning VirtualListView via GWLP_USERDATA and handles
+ * painting, scrolling and sizing of the virtual rows
+ * @param hwnd Window handle
+ * @param uMsg Window message queue feed
+ * @param wParam Word parameter
+ * @param lParam Long parameter
+ * @return
+ */
+LRESULT CALLBACK VirtualListView::ListWindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
+    if (uMsg == WM_NCCREATE) {
+        const auto *cs = reinterpret_cast<const CREATESTRUCTW *>(lParam);
+        auto *self = static_cast<VirtualListView *>(cs->lpCreateParams);
+        SetWindowLongPtrW(hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(self));
+
+        // Known before CreateWindowExW returns, as WM_SIZE already scrolls and paints
+        if (self) self->hList = hwnd;
+        return DefWindowProcW(hwnd, uMsg, wParam, lParam);
+    }
+
+    auto *self = reinterpret_cast<VirtualListView *>(GetWindowLongPtrW(hwnd, GWLP_USERDATA));
+    if (!self) return DefWindowProcW(hwnd, uMsg, wParam, lParam);
+
+    switch (uMsg) {
+        // Viewport changes resize the row cache and the scroll bar page
+        case WM_SIZE: {
+            self->model.SetViewport(LOWORD(lParam), HIWORD(lParam));
+            self->UpdateScrollBar();
+            InvalidateRect(hwnd, nullptr, FALSE);
+            return 0;
+        }
+
+        // Paint covers the whole client area, so skipping the erase avoids flicker
+        case WM_ERASEBKGND:
+            return 1;
+
+        // Only rows intersecting the invalid region are drawn
+        case WM_PAINT: {
+            PAINTSTRUCT ps;
+            HDC hdc = BeginPaint(hwnd, &ps);
+            self->Paint(hdc, ps.rcPaint);
+            EndPaint(hwnd, &ps);
+            return 0;
+        }
+
+        case WM_VSCROLL:
+            self->OnVScroll(LOWORD(wParam));
+            return 0;
+
+        // Wheel deltas are accumulated so high resolution wheels still scroll whole rows
+        case WM_MOUSEWHEEL: {
+            self->wheelRemainder += GET_WHEEL_DELTA_WPARAM(wParam);
+            const int notches = self->wheelRemainder / WHEEL_DELTA;
+            self->wheelRemainder -= notches * WHEEL_DELTA;
+
+            if (notches) {
+                self->ApplyScroll(self->model.ScrollBy(-static_cast<std::int64_t>(notches) * kWheelRows));
+            }
+            return 0;
+        }
+
+        case WM_KEYDOWN: {
+            const auto page = static_cast<std::int64_t>(self->model.PageRows());
+
+            switch (wParam) {
+                case VK_UP:    self->ApplyScroll(self->model.ScrollBy(-1)); return 0;
+                case VK_DOWN:  self->ApplyScroll(self->model.ScrollBy(1)); return 0;
+                case VK_PRIOR: self->ApplyScroll(self->model.ScrollBy(-page)); return 0;
+                case VK_NEXT:  self->ApplyScroll(self->model.ScrollBy(page)); return 0;
+                case VK_HOME:  self->ApplyScroll(self->model.ScrollTo(0)); return 0;
+                case VK_END:   self->ApplyScroll(self->model.ScrollTo(self->model.MaxTopRow())); return 0;
+                default: break;
+            }
+            break;
+        }
+
+        case WM_LBUTTONDOWN:
+            SetFocus(hwnd);
+            return 0;
+
+        // Detaching the VirtualListView pointer from this HWND
+        case WM_NCDESTROY:
+            SetWindowLongPtrW(hwnd, GWLP_USERDATA, 0);
+            self->hList = nullptr;
+            return DefWindowProcW(hwnd, uMsg, wParam, lParam);
+
+        default:
+            break;
+    }
+
+    return DefWindowProcW(hwnd, uMsg, wParam, lParam);
+}
+
+// Draws the rows intersecting 'dirty' and fills whatever lies below the last row
+void VirtualListView::Paint(HDC hdc, const RECT &dirty) {
+    const RowRange rows = model.RowsInBand(dirty.top, dirty.bottom);
+    const std::size_t columns = model.ColumnCount();
+    const int rowHeight = model.RowHeight();
+
+    HFONT old = hFont ? static_cast<HFONT>(SelectObject(hdc, hFont)) : nullptr;
+    SetBkMode(hdc, TRANSPARENT);
+    SetTextColor(hdc, textColor);
+
+    for (std::size_t row = rows.first; row < rows.last; ++row) {
+        const int top = model.RowTop(row);
+        RECT rowRect{dirty.left, top, dirty.right, top + rowHeight};
+        FillRect(hdc, &rowRect, bgBrush);
+
+        const auto &cells = model.RowAt(row);
+
+        for (std::size_t col = 0; col < columns; ++col) {
+            const int left = model.ColumnLeft(col);
+            const int right = left + model.ColumnWidth(col);
+            if (right <= dirty.left || left >= dirty.right) continue;
+
+            RECT cellRect{left + kCellPadding, top, right - kCellPadding, top + rowHeight};
+            DrawTextW(hdc, cells[col].c_str(), static_cast<int>(cells[col].size()), &cellRect,
+                      DT_LEFT | DT_VCENTER | DT_SINGLELINE | DT_END_ELLIPSIS | DT_NOPREFIX);
+
+            RECT separator{right - 1, top, right, top + rowHeight};
+            FillRect(hdc, &separator, gridBrush);
+        }
+
+        RECT gridLine{dirty.left, top + rowHeight - 1, dirty.right, top + rowHeight};
+        FillRect(hdc, &gridLine, gridBrush);
+    }
+
+    // Background below the last row when the data doesn't fill the viewport
+    const int filled = rows.Empty() ? 0 : model.RowTop(rows.last - 1) + rowHeight;
+    if (rows.last >= model.RowCount() && filled < dirty.bottom) {
+        RECT rest{dirty.left, std::max<int>(filled, dirty.top), dirty.right, dirty.bottom};
+        FillRect(hdc, &rest, bgBrush);
+    }
+
+    if (old) SelectObject(hdc, old);
+}
+
+// Blits the still visible rows and synchronously paints only the exposed band
+void VirtualListView::ApplyScroll(const ScrollResult &result) {
+    if (!hList || (!result.repaintAll && result.pixels == 0)) return;
+
+    if (result.repaintAll) {
+        InvalidateRect(hList, nullptr, FALSE);
+    } else {
+        ScrollWindowEx(hList, 0, static_cast<int>(result.pixels), nullptr, nullptr, nullptr, nullptr, SW_INVALIDATE);
+    }
+
+    UpdateScrollBar();
+    UpdateWindow(hList);
+}
+
+// Scroll bar works in rows, scaled down when the row count doesn't fit its int range
+void VirtualListView::UpdateScrollBar() {
+    if (!hList) return;
+
+    const std::size_t scale = ScrollScale();
+
+    SCROLLINFO si{};
+    si.cbSize = sizeof(si);
+    si.fMask = SIF_RANGE | SIF_PAGE | SIF_POS | SIF_DISABLENOSCROLL;
+    si.nMin = 0;
+    si.nMax = model.RowCount() ? static_cast<int>((model.RowCount() - 1) / scale) : 0;
+    si.nPage = static_cast<UINT>(std::max<std::size_t>(model.PageRows() / scale, 1));
+    si.nPos = static_cast<int>(model.TopRow() / scale);
+
+    SetScrollInfo(hList, SB_VERT, &si, TRUE);
+}
+
+// Maps scroll bar requests to row moves
+void VirtualListView::OnVScroll(int request) {
+    const auto page = static_cast<std::int64_t>(model.PageRows());
+
+    switch (request) {
+        case SB_LINEUP:   ApplyScroll(model.ScrollBy(-1)); break;
+        case SB_LINEDOWN: ApplyScroll(model.ScrollBy(1)); break;
+        case SB_PAGEUP:   ApplyScroll(model.ScrollBy(-page)); break;
+        case SB_PAGEDOWN: ApplyScroll(model.ScrollBy(page)); break;
+        case SB_TOP:      ApplyScroll(model.ScrollTo(0)); break;
+        case SB_BOTTOM:   ApplyScroll(model.ScrollTo(model.MaxTopRow())); break;
+
+        // 32-bit track position, the 16-bit one in wParam can't address large lists
+        case SB_THUMBTRACK:
+        case SB_THUMBPOSITION: {
+            SCROLLINFO si{};
+            si.cbSize = sizeof(si);
+            si.fMask = SIF_TRACKPOS;
+            GetScrollInfo(hList, SB_VERT, &si);
+            ApplyScroll(model.ScrollTo(static_cast<std::size_t>(si.nTrackPos) * ScrollScale()));
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+std::size_t VirtualListView::ScrollScale() const {
+    return model.RowCount() / kMaxScrollRange + 1;
+}
@@ -1,10 +1,13 @@
 #include <Windows.h>
+#include <algorithm>
 #include <cwchar>
 #include <dwmapi.h>
 #include <random>
 
 #include "app/AppState.h"
 #include "app/ButtonManager.h"
+#include "app/TimerWheel.h"
+#include "app/VirtualListView.h"
 #include "Resource.h"
 #include "app/WindowProcHandler.h"
 
@@ -15,16 +18,122 @@ namespace {
     constexpr int kBtnClickId = 1;
     constexpr int kBtnRandomId = 2;
 
-    constexpr COLORREF kChildBg = RGB(30, 30, 30);
-
     constexpr DWORD kUseImmersiveDarkMode = 20;
 
+    // WM_TIMER driving the timer wheel while a modal loop runs, its period is capped so deadlines
+    // scheduled from inside the modal loop are still seen within one slice
+    constexpr UINT_PTR kModalTimerId = 1;
+    constexpr ULONGLONG kModalTimerSliceMs = 100;
+
+    // Function arms the modal WM_TIMER for the wheel's nearest deadline
+    void ArmModalTimer(HWND hwnd, const AppState *state) {
+        if (!state || !state->timers) return;
+
+        ULONGLONG delay = kModalTimerSliceMs;
+        if (const auto next = state->timers->NextDeadline()) {
+            const ULONGLONG now = GetTickCount64();
+            delay = std::min(delay, *next > now ? *next - now : 0);
+        }
+
+        SetTimer(hwnd, kModalTimerId, static_cast<UINT>(std::max<ULONGLONG>(delay, USER_TIMER_MINIMUM)), nullptr);
+    }
+
+    // Function does one iteration of main's loop from inside a modal loop: fires due timers, flushes and re-arms
+    void OnModalTimer(HWND hwnd, AppState *state) {
+        if (!state || !state->timers) return;
+
+        state->timers->Advance(GetTickCount64());
+        state->changes.Flush();
+        ArmModalTimer(hwnd, state);
+    }
+
     // Function generates random RGB value for the parent window background
     COLORREF RandomColour() {
         static std::mt19937 gen{std::random_device{}()};
         static std::uniform_int_distribution<int> dis(0, 255);
         return RGB(dis(gen), dis(gen), dis(gen));
     }
+
+    // Function reads a role colour from the active theme, falling back to the built-in default
+    COLORREF ThemeColour(const AppState *state, ThemeRole role) {
+        return state && state->theme ? state->theme->RoleColour(role) : kDefaultTheme[role];
+    }
+
+    // Function drops the child window's theme registrations, their callbacks capture its handles
+    void ReleaseChildTheme(AppState *state) {
+        if (!state || !state->theme || state->childThemeId == ThemeEngine::kNoControl) return;
+
+        state->theme->Unregister(state->childThemeId);
+        state->theme->Unregister(state->childOkThemeId);
+        state->childThemeId = ThemeEngine::kNoControl;
+        state->childOkThemeId = ThemeEngine::kNoControl;
+        state->childThemeHwnd = nullptr;
+    }
+
+    // Function keeps the child window's theme registrations in step with the tracked child handle,
+    // one batch may hold a close and a reopen, so the registered handle is compared, not just its presence
+    void SyncChildTheme(AppState *state) {
+        if (!state || !state->theme) return;
+
+        HWND child = state->childHwnd.Get();
+        if (!child || !IsWindow(child)) child = nullptr;
+
+        if (state->childThemeHwnd != child) {
+            ReleaseChildTheme(state);
+        }
+
+        if (child && state->childThemeId == ThemeEngine::kNoControl) {
+            state->childThemeHwnd = child;
+            state->childThemeId = state->theme->Register(
+                {ThemeRole::ChildBg, ThemeRole::LabelText, ThemeRole::ChildBg},
+                [child](const Style &style) {
+                    WindowProcHandler::ApplyTitleBarTheme(child, style.bg);
+                    RedrawWindow(child, nullptr, nullptr, RDW_INVALIDATE | RDW_ERASE | RDW_ALLCHILDREN);
+                });
+
+            HWND okButton = GetDlgItem(child, kChildOkId);
+            state->childOkThemeId = state->theme->Register(
+                {ThemeRole::ButtonBg, ThemeRole::ButtonText, ThemeRole::ButtonBorder},
+                [okButton](const Style &) {
+                    if (okButton) InvalidateRect(okButton, nullptr, FALSE);
+                });
+        }
+    }
+
+    // Function lays out the parent buttons and colour list for the current client size
+    void LayoutControls(const AppState *state) {
+        if (!state->btn1 || !state->btn2) return;
+
+        const int w = state->clientSize.Get().width;
+        const int h = state->clientSize.Get().height;
+
+        state->btn1->ComputeResize(w, h);
+        state->btn2->ComputeResize(w, h);
+
+        const int bw = state->btn1->GetWidth();
+        const int bh = state->btn1->GetHeight();
+
+        state->btn1->SetSizeAndPosition((w - bw) / 2 - bw, (h - bh) / 2, bw, bh);
+        state->btn2->SetSizeAndPosition((w - bw) / 2 + bw, (h - bh) / 2, bw, bh);
+
+        // List spans both buttons and fills the space below them, half a button height from each edge
+        if (state->list) {
+            const int top = (h + bh) / 2 + bh / 2;
+            state->list->SetSizeAndPosition((w - bw) / 2 - bw, top, 3 * bw, std::max(h - top - bh / 2, 0));
+        }
+    }
+}
+
+/**
+ * Switches the window's title bar between dark and light mode to match the background it is themed with
+ * @param hwnd Top-level window handle
+ * @param background Colour the client area is filled with
+ */
+void WindowProcHandler::ApplyTitleBarTheme(HWND hwnd, COLORREF background) {
+    const BOOL dark = IsDarkColour(background) ? TRUE : FALSE;
+    if (FAILED(DwmSetWindowAttribute(hwnd, kUseImmersiveDarkMode, &dark, sizeof(dark)))) {
+        OutputDebugStringW(L"DwmSetWindowAttribute: dark mode failed\n");
+    }
 }
 
 /**
@@ -43,7 +152,7 @@ LRESULT CALLBACK WindowProcHandler::ChildWindowProc(HWND hwnd, UINT uMsg, WPARAM
 
         SetWindowLongPtrW(hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(state));
 
-        if (state) state->childHwnd = hwnd;
+        if (state) state->childHwnd.Set(hwnd);
         return TRUE;
     }
 
@@ -132,7 +241,7 @@ LRESULT CALLBACK WindowProcHandler::ChildWindowProc(HWND hwnd, UINT uMsg, WPARAM
             RECT rc;
             GetClientRect(hwnd, &rc);
 
-            HBRUSH b = CreateSolidBrush(kChildBg);
+            HBRUSH b = CreateSolidBrush(ThemeColour(state, ThemeRole::ChildBg));
             FillRect(hdc, &rc, b);
             DeleteObject(b);
 
@@ -142,7 +251,7 @@ LRESULT CALLBACK WindowProcHandler::ChildWindowProc(HWND hwnd, UINT uMsg, WPARAM
         // Ensuring readable light font on dark background
         case WM_CTLCOLORSTATIC: {
             HDC hdc = reinterpret_cast<HDC>(wParam);
-            SetTextColor(hdc, RGB(255, 255, 255));
+            SetTextColor(hdc, ThemeColour(state, ThemeRole::LabelText));
             SetBkMode(hdc, TRANSPARENT);
             return reinterpret_cast<LRESULT>(GetStockObject(NULL_BRUSH));
         }
@@ -183,6 +292,22 @@ LRESULT CALLBACK WindowProcHandler::ChildWindowProc(HWND hwnd, UINT uMsg, WPARAM
             return 0;
         }
 
+        // Dragging or the system menu of the child starves main's loop, the wheel is driven from WM_TIMER meanwhile
+        case WM_ENTERSIZEMOVE:
+        case WM_ENTERMENULOOP:
+            ArmModalTimer(hwnd, state);
+            break;
+
+        case WM_EXITSIZEMOVE:
+        case WM_EXITMENULOOP:
+            KillTimer(hwnd, kModalTimerId);
+            break;
+
+        case WM_TIMER:
+            if (wParam != kModalTimerId) break;
+            OnModalTimer(hwnd, state);
+            return 0;
+
         // When user confirms exiting child window on dialog, it destroys it
         case WM_COMMAND: {
             if (LOWORD(wParam) == kChildOkId) {
@@ -195,8 +320,11 @@ LRESULT CALLBACK WindowProcHandler::ChildWindowProc(HWND hwnd, UINT uMsg, WPARAM
         //  Clearing GWLP_USERDATA upon child window destruction
         case WM_DESTROY:
             if (state) {
+                // Released right away, a new child created in the same batch may get this handle back
+                if (state->childThemeHwnd == hwnd) ReleaseChildTheme(state);
+
                 state->childOpen = false;
-                if (state->childHwnd == hwnd) state->childHwnd = nullptr;
+                if (state->childHwnd.Get() == hwnd) state->childHwnd.Set(nullptr);
             }
             return 0;
 
@@ -233,26 +361,56 @@ LRESULT CALLBACK WindowProcHandler::WindowProc(HWND hwnd, UINT uMsg, WPARAM wPar
     auto *state = reinterpret_cast<AppState *>(GetWindowLongPtrW(hwnd, GWLP_USERDATA));
 
     switch (uMsg) {
-        // Sets the dimensions and position of elements in parent window
-        case WM_SIZE: {
-            if (!state || !state->btn1 || !state->btn2) return 0;
+        // Subscribes layout, paint and child window handling to state changes, each runs once per batch
+        case WM_CREATE: {
+            if (!state) return 0;
 
-            const int w = LOWORD(lParam);
-            const int h = HIWORD(lParam);
+            state->layoutSubscription = state->changes.Subscribe(
+                AppState::kClientSizeChanged,
+                [state](ChangeMask) { LayoutControls(state); });
+
+            state->paintSubscription = state->changes.Subscribe(
+                AppState::kBgColorChanged | AppState::kClientSizeChanged,
+                [hwnd](ChangeMask) { InvalidateRect(hwnd, nullptr, TRUE); });
 
-            state->btn1->ComputeResize(w, h);
-            state->btn2->ComputeResize(w, h);
+            state->childSubscription = state->changes.Subscribe(
+                AppState::kChildHwndChanged,
+                [state](ChangeMask) { SyncChildTheme(state); });
 
-            const int bw = state->btn1->GetWidth();
-            const int bh = state->btn1->GetHeight();
+            return 0;
+        }
+
+        // Records the new client size, layout and repaint follow from the next batch, flushed before the next paint
+        case WM_SIZE: {
+            if (!state) return 0;
 
-            state->btn1->SetSizeAndPosition((w - bw) / 2 - bw, (h - bh) / 2, bw, bh);
-            state->btn2->SetSizeAndPosition((w - bw) / 2 + bw, (h - bh) / 2, bw, bh);
+            state->clientSize.Set({LOWORD(lParam), HIWORD(lParam)});
 
-            InvalidateRect(hwnd, nullptr, TRUE);
+            // The modal sizing loop starves main's loop, so live resizes are flushed right away
+            if (state->inSizeMove) {
+                state->changes.Flush();
+            }
             return 0;
         }
 
+        // Modal sizing and menu loops bypass main's loop, the wheel is driven from WM_TIMER until they end
+        case WM_ENTERSIZEMOVE:
+        case WM_ENTERMENULOOP:
+            if (state && uMsg == WM_ENTERSIZEMOVE) state->inSizeMove = true;
+            ArmModalTimer(hwnd, state);
+            break;
+
+        case WM_EXITSIZEMOVE:
+        case WM_EXITMENULOOP:
+            if (state && uMsg == WM_EXITSIZEMOVE) state->inSizeMove = false;
+            KillTimer(hwnd, kModalTimerId);
+            break;
+
+        case WM_TIMER:
+            if (wParam != kModalTimerId) break;
+            OnModalTimer(hwnd, state);
+            return 0;
+
         // Handling of parent buttons' Win32 logic, by checking click ID and performing appropriate action
         case WM_COMMAND: {
             if (!state) return 0;
@@ -261,12 +419,13 @@ LRESULT CALLBACK WindowProcHandler::WindowProc(HWND hwnd, UINT uMsg, WPARAM wPar
             // When clicking the "Click Here" button, if child wnd is already open (refocuses) otherwise creates one
             if (id == kBtnClickId) {
                 // Child exists then just restores or refocuses
-                if (state->childHwnd && IsWindow(state->childHwnd)) {
-                    if (IsIconic(state->childHwnd)) {
-                        ShowWindow(state->childHwnd, SW_RESTORE);
+                HWND existing = state->childHwnd.Get();
+                if (existing && IsWindow(existing)) {
+                    if (IsIconic(existing)) {
+                        ShowWindow(existing, SW_RESTORE);
                     }
-                    if (GetForegroundWindow() != state->childHwnd) {
-                        SetForegroundWindow(state->childHwnd);
+                    if (GetForegroundWindow() != existing) {
+                        SetForegroundWindow(existing);
                     }
                     return 0;
                 }
@@ -307,19 +466,15 @@ LRESULT CALLBACK WindowProcHandler::WindowProc(HWND hwnd, UINT uMsg, WPARAM wPar
                 );
 
                 if (hChildWnd) {
-                    state->childHwnd = hChildWnd;
+                    state->childHwnd.Set(hChildWnd);
                     state->childOpen = true;
 
-                    DWORD attributeValue = 1;
-                    if (FAILED(DwmSetWindowAttribute(hChildWnd, kUseImmersiveDarkMode,
-                        &attributeValue, sizeof(attributeValue)))) {
-                        OutputDebugStringW(L"DwmSetWindowAttribute: dark mode failed\n");
-                    }
+                    ApplyTitleBarTheme(hChildWnd, ThemeColour(state, ThemeRole::ChildBg));
 
                     ShowWindow(hChildWnd, SW_SHOW);
                 } else {
                     state->childOpen = false;
-                    state->childHwnd = nullptr;
+                    state->childHwnd.Set(nullptr);
                 }
 
                 return 0;
@@ -327,8 +482,7 @@ LRESULT CALLBACK WindowProcHandler::WindowProc(HWND hwnd, UINT uMsg, WPARAM wPar
 
             // Otherwise the Random button randomizes the parent windows' background
             if (id == kBtnRandomId) {
-                state->bgColor = RandomColour();
-                InvalidateRect(hwnd, nullptr, TRUE);
+                state->bgColor.Set(RandomColour());
                 return 0;
             }
 
@@ -387,7 +541,7 @@ LRESULT CALLBACK WindowProcHandler::WindowProc(HWND hwnd, UINT uMsg, WPARAM wPar
             PAINTSTRUCT ps;
             HDC hdc = BeginPaint(hwnd, &ps);
 
-            COLORREF c = state ? state->bgColor : RGB(20, 20, 20);
+            COLORREF c = state ? state->bgColor.Get() : kDefaultTheme[ThemeRole::WindowBg];
             HBRUSH hBrush = CreateSolidBrush(c);
             FillRect(hdc, &ps.rcPaint, hBrush);
             DeleteObject(hBrush);
@@ -396,13 +550,17 @@ LRESULT CALLBACK WindowProcHandler::WindowProc(HWND hwnd, UINT uMsg, WPARAM wPar
             return 0;
         }
 
+        // The confirmation box runs its own modal loop, the wheel keeps firing through WM_TIMER meanwhile
         case WM_CLOSE: {
+            ArmModalTimer(hwnd, state);
             const int result = MessageBoxW(hwnd, L"Do you want to close the window?", L"Confirmation",
                                            MB_YESNO | MB_ICONQUESTION);
+            KillTimer(hwnd, kModalTimerId);
+
             if (result == IDYES) {
-                if (state && state->childHwnd && IsWindow(state->childHwnd)) {
-                    DestroyWindow(state->childHwnd);
-                    state->childHwnd = nullptr;
+                if (state && state->childHwnd.Get() && IsWindow(state->childHwnd.Get())) {
+                    DestroyWindow(state->childHwnd.Get());
+                    state->childHwnd.Set(nullptr);
                     state->childOpen = false;
                 }
                 DestroyWindow(hwnd);
@@ -421,12 +579,18 @@ LRESULT CALLBACK WindowProcHandler::WindowProc(HWND hwnd, UINT uMsg, WPARAM wPar
             SetWindowLongPtrW(hwnd, GWLP_USERDATA, 0);
 
             if (dyingState) {
-                if (dyingState->childHwnd && IsWindow(dyingState->childHwnd)) {
-                    DestroyWindow(dyingState->childHwnd);
-                    dyingState->childHwnd = nullptr;
+                if (dyingState->childHwnd.Get() && IsWindow(dyingState->childHwnd.Get())) {
+                    DestroyWindow(dyingState->childHwnd.Get());
+                    dyingState->childHwnd.Set(nullptr);
                     dyingState->childOpen = false;
                 }
 
+                // No batch will reach the subscribers anymore, so the child theme is released here
+                SyncChildTheme(dyingState);
+                dyingState->changes.Unsubscribe(dyingState->layoutSubscription);
+                dyingState->changes.Unsubscribe(dyingState->paintSubscription);
+                dyingState->changes.Unsubscribe(dyingState->childSubscription);
+
                 if (dyingState->childLabelFont) {
                     DeleteObject(dyingState->childLabelFont);
                     dyingState->childLabelFont = nullptr;
@@ -1,110 +1,93 @@
-#include <dwmapi.h>
-#include <memory>
+#include <algorithm>
+#include <functional>
+#include <string>
 #include <Windows.h>
 
-#include <Resource.h>
-#include "app/AppState.h"
-#include "app/ButtonManager.h"
-#include "app/WindowProcHandler.h"
+#include "app/MainWindow.h"
+#include "app/StateStore.h"
+#include "app/Theme.h"
+#include "app/ThemeEngine.h"
+#include "app/TimerWheel.h"
 
 namespace {
-    constexpr wchar_t kClassName[] = L"MyWindowClass";
-    constexpr wchar_t kWindowTitle[] = L"Basic C++ Win32 Application";
+    // User theme picked up from the working directory and re-read whenever it is saved
+    constexpr wchar_t kThemeFileName[] = L"theme.ini";
+    constexpr ULONGLONG kThemePollMs = 1000;
 
-    constexpr int kInitialWidth = 1280;
-    constexpr int kInitialHeight = 720;
+    // Milliseconds until the loop needs to run again, INFINITE when neither timers nor state changes are pending
+    DWORD WaitTimeout(const TimerWheel &timers, const ChangeBus &changes) {
+        if (changes.HasPending()) return 0;
 
-    constexpr INT_PTR kBtnClickId = 1;
-    constexpr INT_PTR kBtnRandomId = 2;
+        const auto next = timers.NextDeadline();
+        if (!next) return INFINITE;
 
-    constexpr DWORD kUseImmersiveDarkMode = 20;
+        const ULONGLONG now = GetTickCount64();
+        if (*next <= now) return 0;
+
+        return static_cast<DWORD>(std::min<ULONGLONG>(*next - now, INFINITE - 1));
+    }
 }
 
 int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int) {
-    // 1) Registering the window class as per Win32 documentation
-    WNDCLASSW wc{};
-    wc.lpfnWndProc = WindowProcHandler::WindowProc;
-    wc.hInstance = hInstance;
-    wc.lpszClassName = kClassName;
-    wc.hIcon = static_cast<HICON>(LoadImageW(
-        hInstance,
-        MAKEINTRESOURCEW(IDI_ICON1),
-        IMAGE_ICON,
-        0, 0,
-        LR_DEFAULTSIZE | LR_SHARED
-    ));
-
-    if (!RegisterClassW(&wc)) {
+    // 1) Registering the window class
+    if (!MainWindow::RegisterWindowClass(hInstance)) {
         return 0;
     }
 
-    // 2) Creating app state and passing its pointer to the window via lpCreateParams
-    auto state = std::make_unique<AppState>();
-    AppState *stateRaw = state.get();
-
-    // 3) Creates the parent window and stores the handle into local var
-    HWND hwnd = CreateWindowExW(
-        0,
-        kClassName,
-        L"",
-        WS_OVERLAPPEDWINDOW,
-        CW_USEDEFAULT, CW_USEDEFAULT,
-        kInitialWidth, kInitialHeight,
-        nullptr, nullptr,
-        hInstance,
-        stateRaw
-    );
-
-    // If window creation fails, terminates the program
-    if (!hwnd) {
+    // 2) The timer wheel, theme engine and change bus live here so they outlive every window using them
+    TimerWheel timers(GetTickCount64());
+    ThemeEngine theme(kDefaultTheme);
+    ChangeBus changes;
+
+    // Polling the user theme file on the timer wheel, the first poll runs before the window exists so it
+    // starts with the user's colours, later reloads are applied as a diff
+    ThemeFileWatcher themeFile(kThemeFileName);
+    std::function<void()> pollTheme = [&] {
+        std::string error;
+        if (const auto table = themeFile.Poll(&error)) {
+            theme.Apply(*table);
+        } else if (!error.empty()) {
+            OutputDebugStringA(("theme.ini: " + error + "\n").c_str());
+        }
+        timers.Schedule(kThemePollMs, pollTheme);
+    };
+    pollTheme();
+
+    // 3) Creates and shows the parent window with its buttons, terminates the program if that fails
+    MainWindow mainWindow(hInstance, timers, theme, changes);
+    if (!mainWindow.GetHwnd()) {
         return 0;
     }
 
-    // The window now owns 'stateRaw' and will delete it in WM_NCDESTROY.
-    [[maybe_unused]] AppState *ownedByWindow = state.release();
-
-    // 4) Creating the buttons
-    ButtonManager button1(
-        hwnd, hInstance,
-        0, 0,
-        5, 7,
-        L"Click Here",
-        RGB(35, 35, 35), RGB(255, 255, 255), RGB(255, 255, 255),
-        32, L"Helvetica",
-        reinterpret_cast<HMENU>(kBtnClickId)
-    );
-
-    ButtonManager button2(
-        hwnd, hInstance,
-        0, 0,
-        5, 7,
-        L"Random Color",
-        RGB(35, 35, 35), RGB(255, 255, 255), RGB(255, 255, 255),
-        32, L"Helvetica",
-        reinterpret_cast<HMENU>(kBtnRandomId)
-    );
-
-    // Stores button pointers into the app state
-    stateRaw->btn1 = &button1;
-    stateRaw->btn2 = &button2;
-
-    // Attempts to set the Window to dark mode using custom constant
-    const DWORD enable = TRUE;
-    if (FAILED(DwmSetWindowAttribute(hwnd, kUseImmersiveDarkMode, &enable, sizeof(enable)))) {
-        OutputDebugStringW(L"Dark Mode failed \n");
-    }
-
-    // 5) Shows the window and runs the message loop
-    ShowWindow(hwnd, SW_MAXIMIZE);
-    SetWindowTextW(hwnd, kWindowTitle);
-    UpdateWindow(hwnd);
-
+    // 4) Message loop, timers are advanced before dispatching so handlers schedule relative to a fresh time, state
+    // changes from both are flushed as one batch (or earlier, right before a WM_PAINT), then the thread sleeps
+    // until input or a deadline
     MSG msg{};
-    while (GetMessageW(&msg, nullptr, 0, 0) > 0) {
-        TranslateMessage(&msg);
-        DispatchMessageW(&msg);
+    bool running = true;
+    while (running) {
+        timers.Advance(GetTickCount64());
+
+        while (PeekMessageW(&msg, nullptr, 0, 0, PM_REMOVE)) {
+            if (msg.message == WM_QUIT) {
+                running = false;
+                break;
+            }
+
+            // Layout only happens on a flush, so a pending batch is applied before the paint it would invalidate
+            if (msg.message == WM_PAINT) {
+                changes.Flush();
+            }
+
+            TranslateMessage(&msg);
+            DispatchMessageW(&msg);
+        }
+
+        if (running) {
+            changes.Flush();
+            MsgWaitForMultipleObjectsEx(0, nullptr, WaitTimeout(timers, changes), QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+        }
     }
 
-    UnregisterClassW(kClassName, hInstance);
+    MainWindow::UnregisterWindowClass(hInstance);
     return 0;
 }